@@ -64,67 +64,6 @@ namespace riscv_tlm {
         using signed_T = typename std::make_signed<T>::type;
         using unsigned_T = typename std::make_unsigned<T>::type;
 
-        /**
-         * @brief Access to opcode field
-         * @return return opcode field
-         */
-        inline unsigned_T opcode() const override {
-            return static_cast<unsigned_T>(this->m_instr.range(31, 27));
-        }
-
-        /**
-         * @brief Decodes opcode of instruction
-         * @return opcode of instruction
-         */
-        op_A_Codes decode() const {
-
-            switch (opcode()) {
-                case A_LR:
-                    return OP_A_LR;
-                    break;
-                case A_SC:
-                    return OP_A_SC;
-                    break;
-                case A_AMOSWAP:
-                    return OP_A_AMOSWAP;
-                    break;
-                case A_AMOADD:
-                    return OP_A_AMOADD;
-                    break;
-                case A_AMOXOR:
-                    return OP_A_AMOXOR;
-                    break;
-                case A_AMOAND:
-                    return OP_A_AMOAND;
-                    break;
-                case A_AMOOR:
-                    return OP_A_AMOOR;
-                    break;
-                case A_AMOMIN:
-                    return OP_A_AMOMIN;
-                    break;
-                case A_AMOMAX:
-                    return OP_A_AMOMAX;
-                    break;
-                case A_AMOMINU:
-                    return OP_A_AMOMINU;
-                    break;
-                case A_AMOMAXU:
-                    return OP_A_AMOMAXU;
-                    break;
-                    [[unlikely]] default:
-                    return OP_A_ERROR;
-                    break;
-
-            }
-
-            return OP_A_ERROR;
-        }
-
-        inline void dump() const override {
-            std::cout << std::hex << "0x" << this->m_instr << std::dec << std::endl;
-        }
-
         bool Exec_A_LR() {
             std::uint32_t mem_addr = 0;
             int rd, rs1, rs2;
@@ -148,10 +87,10 @@ namespace riscv_tlm {
 
             TLB_reserve(mem_addr);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.LR.W: x{:d}(0x{:x}) -> x{:d}(0x{:x}) ",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.LR.W: x{:d}(0x{:x}) -> x{:d}(0x{:x}) ",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, mem_addr, rd, data);
 
             return true;
         }
@@ -176,10 +115,10 @@ namespace riscv_tlm {
                 this->regs->setValue(rd, 1);  // SC writes nonzero on failure
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.SC.W: (0x{:x}) <- x{:d}(0x{:x}) ",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                mem_addr, rs2, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.SC.W: (0x{:x}) <- x{:d}(0x{:x}) ",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    mem_addr, rs2, data);
 
             return true;
         }
@@ -208,7 +147,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, aux, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOSWAP");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOSWAP");
 
             return true;
         }
@@ -236,7 +175,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOADD");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOADD");
 
             return true;
         }
@@ -264,7 +203,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOXOR");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOXOR");
 
             return true;
         }
@@ -292,7 +231,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOAND");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOAND");
 
             return true;
         }
@@ -320,7 +259,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOOR");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOOR");
 
             return true;
         }
@@ -352,7 +291,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, aux, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOMIN");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOMIN");
 
             return true;
         }
@@ -384,7 +323,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, aux, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOMAX");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOMAX");
 
             return true;
         }
@@ -416,7 +355,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, aux, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOMINU");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOMINU");
 
             return true;
         }
@@ -448,7 +387,7 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, aux, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. A.AMOMAXU");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. A.AMOMAXU");
 
             return true;
         }
@@ -216,57 +216,63 @@ namespace riscv_tlm {
          * @return funct7 field
          */
         inline std::uint32_t get_funct7() const {
-            return this->m_instr.range(31, 25);
+            return fields::funct7(this->m_instr);
         }
 
         /**
-         * @brief Access to funct7 field in case of RV64 SLLL, SRLI, SRAI is different
-         * @return funct7 field
+         * @brief Set the flag raised by WFI
+         * @param flag CPU flag, checked after every step
          */
-        std::uint32_t get_funct7b() const;
+        void setWFIFlag(bool *flag) {
+            wfi_flag = flag;
+        }
 
         /**
          * @brief Gets immediate field value for I-type
          * @return immediate_I field
-         * @note Specialized
          */
-        signed_T get_imm_I() const;
+        inline signed_T get_imm_I() const {
+            return fields::imm_I(this->m_instr);
+        }
 
         /**
          * @brief Gets immediate field value for S-type
          * @return immediate_S field
-         * @note Specialized
          */
-         signed_T get_imm_S() const;
+        inline signed_T get_imm_S() const {
+            return fields::imm_S(this->m_instr);
+        }
 
         /**
          * @brief Gets immediate field value for U-type
          * @return immediate_U field
          */
         inline unsigned_T get_imm_U() const {
-            return this->m_instr.range(31, 12);
+            return fields::imm_U(this->m_instr);
         }
 
         /**
          * @brief Gets immediate field value for B-type
          * @return immediate_B field
-         * @note Specialized
          */
-        signed_T get_imm_B() const;
+        inline signed_T get_imm_B() const {
+            return fields::imm_B(this->m_instr);
+        }
 
         /**
          * @brief Gets immediate field value for J-type
          * @return immediate_J field
-         * @note Specialized
          */
-        signed_T get_imm_J() const;
+        inline signed_T get_imm_J() const {
+            return fields::imm_J(this->m_instr);
+        }
 
         /**
          * @brief Returns shamt field for Shifts instructions
          * @return value corresponding to inst(25:20)
          */
         inline unsigned_T get_shamt() const {
-            return this->m_instr.range(25, 20);
+            return fields::shamt(this->m_instr);
         }
 
         /**
@@ -274,15 +280,7 @@ namespace riscv_tlm {
          * @return value corresponding to instr(31:20)
          */
         inline unsigned_T get_csr() const {
-            return this->m_instr.range(31, 20);
-        }
-
-        /**
-         * @brief Access to opcode field
-         * @return return opcode field
-         */
-        inline unsigned_T opcode() const override {
-            return this->m_instr.range(6, 0);
+            return fields::csr(this->m_instr);
         }
 
         bool Exec_LUI() const {
@@ -293,9 +291,9 @@ namespace riscv_tlm {
             imm = static_cast<std::int32_t>(get_imm_U() << 12);
             this->regs->setValue(rd, imm);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LUI: x{:d} <- 0x{:x}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rd, imm);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LUI: x{:d} <- 0x{:x}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rd, imm);
 
             return true;
         }
@@ -311,10 +309,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, new_pc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. AUIPC: x{:d} <- 0x{:x} + PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rd, imm, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. AUIPC: x{:d} <- 0x{:x} + PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rd, imm, new_pc);
 
             return true;
         }
@@ -334,9 +332,9 @@ namespace riscv_tlm {
             old_pc = old_pc + 4;
             this->regs->setValue(rd, old_pc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. JAL: x{:d} <- 0x{:x}. PC + 0x{:x} -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc - 4,
-                                rd, old_pc, mem_addr, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. JAL: x{:d} <- 0x{:x}. PC + 0x{:x} -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc - 4,
+                                    rd, old_pc, mem_addr, new_pc);
 
             return true;
         }
@@ -354,9 +352,9 @@ namespace riscv_tlm {
             new_pc = static_cast<unsigned_T>((this->regs->getValue(rs1) + offset) & ~1);
             this->regs->setValue(rd, old_pc + 4);
             this->regs->setPC(new_pc);
-            this->logger->debug("{} ns. PC: 0x{:x}. JALR: x{:d} <- 0x{:x}. PC <- 0x{:x}",
-                                    sc_core::sc_time_stamp().value(),
-                                    old_pc, rd, old_pc + 4, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. JALR: x{:d} <- 0x{:x}. PC <- 0x{:x}",
+                                        sc_core::sc_time_stamp().value(),
+                                        old_pc, rd, old_pc + 4, new_pc);
 
             return true;
         }
@@ -379,9 +377,9 @@ namespace riscv_tlm {
                 this->regs->incPC();
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. BEQ: x{:d}(0x{:x}) == x{:d}(0x{:x})? -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. BEQ: x{:d}(0x{:x}) == x{:d}(0x{:x})? -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
 
             return true;
         }
@@ -406,9 +404,9 @@ namespace riscv_tlm {
                 this->regs->incPC();
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. BNE: x{:d}(0x{:x}) != x{:d}(0x{:x})? -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, val1, rs2, val2, this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. BNE: x{:d}(0x{:x}) != x{:d}(0x{:x})? -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, val1, rs2, val2, this->regs->getPC());
 
             return true;
         }
@@ -433,9 +431,9 @@ namespace riscv_tlm {
                 this->regs->incPC();
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. BLT: x{:d}(0x{:x}) < x{:d}(0x{:x})? -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. BLT: x{:d}(0x{:x}) < x{:d}(0x{:x})? -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
 
             return true;
         }
@@ -460,9 +458,9 @@ namespace riscv_tlm {
                 this->regs->incPC();
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. BGE: x{:d}(0x{:x}) > x{:d}(0x{:x})? -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. BGE: x{:d}(0x{:x}) > x{:d}(0x{:x})? -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
 
             return true;
         }
@@ -487,9 +485,9 @@ namespace riscv_tlm {
                 this->regs->incPC();
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. BLTU: x{:d}(0x{:x}) < x{:d}(0x{:x})? -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. BLTU: x{:d}(0x{:x}) < x{:d}(0x{:x})? -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
 
             return true;
         }
@@ -514,9 +512,9 @@ namespace riscv_tlm {
                 this->regs->incPC();
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. BGEU: x{:d}(0x{:x}) > x{:d}(0x{:x}) -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. BGEU: x{:d}(0x{:x}) > x{:d}(0x{:x}) -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, this->regs->getValue(rs1), rs2, this->regs->getValue(rs2), this->regs->getPC());
 
             return true;
         }
@@ -536,10 +534,10 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LB: x{:d} + x{:d}(0x{:x}) -> x{:d}",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LB: x{:d} + x{:d}(0x{:x}) -> x{:d}",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd);
 
             return true;
         }
@@ -559,10 +557,10 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LH: x{:d} + x{:d}(0x{:x}) -> x{:d}",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LH: x{:d} + x{:d}(0x{:x}) -> x{:d}",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd);
 
             return true;
         }
@@ -583,10 +581,10 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LW: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LW: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd, data);
 
             return true;
         }
@@ -607,10 +605,10 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LBU: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LBU: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd, data);
 
             return true;
         }
@@ -631,10 +629,10 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LHU: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LHU: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd, data);
 
             return true;
         }
@@ -655,10 +653,10 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LWU: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LWU: x{:d} + x{:d}(0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd, data);
 
             return true;
         }
@@ -678,17 +676,15 @@ namespace riscv_tlm {
             offset = this->regs->getValue(rs1);
             mem_addr = imm + offset;
 
-            data = static_cast<std::uint32_t>(this->mem_intf->readDataMem(mem_addr, 4));
-            std::uint64_t aux = static_cast<std::uint32_t>(this->mem_intf->readDataMem(mem_addr + 4, 4));
-            data |= aux << 32;
+            data = this->mem_intf->readDataMem(mem_addr, 8);
 
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. LD: 0x{:x}({:d}) + {:d}(0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, offset, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. LD: 0x{:x}({:d}) + {:d}(0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, offset, imm, mem_addr, rd, data);
             return true;
         }
 
@@ -706,13 +702,12 @@ namespace riscv_tlm {
             mem_addr = imm + this->regs->getValue(rs1);
             data = this->regs->getValue(rs2);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SD: 0x{:x} -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs2, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SD: 0x{:x} -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs2, rs1, imm, mem_addr);
 
-            this->mem_intf->writeDataMem(mem_addr, data & 0xFFFFFFFF, 4);
-            this->mem_intf->writeDataMem(mem_addr + 4, data >> 32, 4);
+            this->mem_intf->writeDataMem(mem_addr, data, 8);
             this->perf->dataMemoryWrite();
 
             return true;
@@ -735,10 +730,10 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 1);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SB: x{:d} -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs2, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SB: x{:d} -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs2, rs1, imm, mem_addr);
 
             return true;
         }
@@ -760,10 +755,10 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 2);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SH: x{:d} -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs2, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SH: x{:d} -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs2, rs1, imm, mem_addr);
 
             return true;
         }
@@ -785,10 +780,10 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SW: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs2, data, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SW: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs2, data, rs1, imm, mem_addr);
 
             return true;
         }
@@ -806,10 +801,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ADDI: x{:d}(0x{:x}) + {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, this->regs->getValue(rs1), imm, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ADDI: x{:d}(0x{:x}) + {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, this->regs->getValue(rs1), imm, rd, calc);
 
             return true;
         }
@@ -829,10 +824,10 @@ namespace riscv_tlm {
             calc = static_cast<std::int32_t>(aux);
 
             this->regs->setValue(rd, calc);
-            this->logger->debug("{} ns. PC: 0x{:x}. ADDIW: x{:d} + {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ADDIW: x{:d} + {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, rd, calc);
 
             return true;
         }
@@ -850,16 +845,16 @@ namespace riscv_tlm {
 
             if (val1 < imm) {
                 this->regs->setValue(rd, 1);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLTI: x{:d} < x{:d} => 1 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, imm, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLTI: x{:d} < x{:d} => 1 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, imm, rd);
             } else {
                 this->regs->setValue(rd, 0);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLTI: x{:d} < x{:d} => 0 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, imm, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLTI: x{:d} < x{:d} => 0 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, imm, rd);
             }
 
             return true;
@@ -877,16 +872,16 @@ namespace riscv_tlm {
 
             if (val1 < imm) {
                 this->regs->setValue(rd, 1);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLTIU: x{:d} < x{:d} => 1 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, imm, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLTIU: x{:d} < x{:d} => 1 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, imm, rd);
             } else {
                 this->regs->setValue(rd, 0);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLTIU: x{:d} < x{:d} => 0 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, imm, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLTIU: x{:d} < x{:d} => 0 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, imm, rd);
             }
 
             return true;
@@ -904,9 +899,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) ^ imm;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. XORI: x{:d} XOR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. XORI: x{:d} XOR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, rd);
 
             return true;
         }
@@ -923,9 +918,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) | imm;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ORI: x{:d} OR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ORI: x{:d} OR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, rd);
 
             return true;
         }
@@ -942,10 +937,10 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) & imm;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ANDI: x{:d} AND 0x{:x} -> x{:d}",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ANDI: x{:d} AND 0x{:x} -> x{:d}",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, rd);
 
             return true;
         }
@@ -982,10 +977,10 @@ namespace riscv_tlm {
             calc = static_cast<std::int32_t>(static_cast<std::uint32_t>(this->regs->getValue(rs1)) << shift);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SLLIW: x{:d} << {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLLIW: x{:d} << {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -1013,10 +1008,10 @@ namespace riscv_tlm {
             calc = static_cast<std::int32_t>(static_cast<std::uint32_t>(this->regs->getValue(rs1) & 0xFFFFFFFF) >> shift);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SRLIW: x{:d} << {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRLIW: x{:d} << {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -1029,17 +1024,17 @@ namespace riscv_tlm {
 
             rd = this->get_rd();
             rs1 = this->get_rs1();
-            rs2 = this->get_shamt_slli();
+            rs2 = this->get_shamt();
 
             shift = rs2 & 0x1F;
 
             calc = static_cast<std::int32_t>(static_cast<std::int32_t>(this->regs->getValue(rs1)) >> shift);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SRAIW: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRAIW: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -1055,10 +1050,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ADDW: x{:d} + x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ADDW: x{:d} + x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -1074,10 +1069,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SUBW: x{:d} + x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SUBW: x{:d} + x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -1097,10 +1092,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SLLW: x{:d} << x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLLW: x{:d} << x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -1120,10 +1115,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SRLW: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRLW: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -1143,10 +1138,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SRAW: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRAW: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -1162,10 +1157,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ADD: x{:d} + x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ADD: x{:d} + x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -1180,10 +1175,10 @@ namespace riscv_tlm {
             calc = static_cast<signed_T>(this->regs->getValue(rs1)) - static_cast<signed_T>(this->regs->getValue(rs2));
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SUB: x{:d} - x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SUB: x{:d} - x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -1204,16 +1199,16 @@ namespace riscv_tlm {
 
             if (val1 < val2) {
                 this->regs->setValue(rd, 1);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLT: x{:d} < x{:d} => 1 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, rs2, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLT: x{:d} < x{:d} => 1 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, rs2, rd);
             } else {
                 this->regs->setValue(rd, 0);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLT: x{:d} < x{:d} => 0 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, rs2, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLT: x{:d} < x{:d} => 0 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, rs2, rd);
             }
 
             return true;
@@ -1232,16 +1227,16 @@ namespace riscv_tlm {
 
             if (val1 < val2) {
                 this->regs->setValue(rd, 1);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLTU: x{:d} < x{:d} => 1 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, rs2, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLTU: x{:d} < x{:d} => 1 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, rs2, rd);
             } else {
                 this->regs->setValue(rd, 0);
-                this->logger->debug("{} ns. PC: 0x{:x}. SLTU: x{:d} < x{:d} => 0 -> x{:d}",
-                                    sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rs1, rs2, rd);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLTU: x{:d} < x{:d} => 0 -> x{:d}",
+                                        sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rs1, rs2, rd);
             }
 
             return true;
@@ -1258,10 +1253,10 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) ^ this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. XOR: x{:d} XOR x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. XOR: x{:d} XOR x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -1283,10 +1278,10 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) | this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. OR: x{:d} OR x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. OR: x{:d} OR x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -1302,16 +1297,16 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) & this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. AND: x{:d} AND x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. AND: x{:d} AND x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
 
         bool Exec_FENCE() const {
-            this->logger->debug("{} ns. PC: 0x{:x}. FENCE", sc_core::sc_time_stamp().value(), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. FENCE", sc_core::sc_time_stamp().value(), this->regs->getPC());
 
             // Check if next instruction is a FENCE, if so, stop simulation
             uint32_t ant_pc = this->regs->getPC();
@@ -1327,7 +1322,7 @@ namespace riscv_tlm {
 
         bool Exec_ECALL() {
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ECALL", sc_core::sc_time_stamp().value(), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ECALL", sc_core::sc_time_stamp().value(), this->regs->getPC());
 
             std::cout << std::endl << "ECALL Instruction called, stopping simulation"
                       << std::endl;
@@ -1342,7 +1337,7 @@ namespace riscv_tlm {
 
         bool Exec_EBREAK() {
 
-            this->logger->debug("{} ns. PC: 0x{:x}. EBREAK", sc_core::sc_time_stamp().value(), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. EBREAK", sc_core::sc_time_stamp().value(), this->regs->getPC());
             std::cout << std::endl << "EBRAK  Instruction called, dumping information"
                       << std::endl;
             this->regs->dump();
@@ -1372,10 +1367,10 @@ namespace riscv_tlm {
 
             this->regs->setCSR(csr, aux2);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. CSRRW: CSR #{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                csr, rd, aux);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. CSRRW: CSR #{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    csr, rd, aux);
 
             return true;
         }
@@ -1389,24 +1384,23 @@ namespace riscv_tlm {
             rs1 = this->get_rs1();
             csr = get_csr();
 
-            if (rd == 0) {
-                this->logger->debug("{} ns. PC: 0x{:x}. CSRRS with rd1 == 0, doing nothing.",
-                                    sc_core::sc_time_stamp().value(), this->regs->getPC());
-                return false;
-            }
-
             /* These operations must be atomical */
             aux = this->regs->getCSR(csr);
             bitmask = this->regs->getValue(rs1);
 
-            this->regs->setValue(rd, aux);
+            if (rd != 0) {
+                this->regs->setValue(rd, aux);
+            }
 
+            /* rs1 == x0 only reads (csrr), the CSR is not written */
             aux2 = aux | bitmask;
-            this->regs->setCSR(csr, aux2);
+            if (rs1 != 0) {
+                this->regs->setCSR(csr, aux2);
+            }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. CSRRS: CSR #{:d}(0x{:x}) -> x{:d}(0x{:x}) & CSR #{:d} <- 0x{:x}",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                csr, aux, rd, rs1, csr, aux2);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. CSRRS: CSR #{:d}(0x{:x}) -> x{:d}(0x{:x}) & CSR #{:d} <- 0x{:x}",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    csr, aux, rd, rs1, csr, aux2);
 
             return true;
         }
@@ -1420,24 +1414,23 @@ namespace riscv_tlm {
             rs1 = this->get_rs1();
             csr = get_csr();
 
-            if (rd == 0) {
-                this->logger->debug("{} ns. PC: 0x{:x}. CSRRC with rd1 == 0, doing nothing.",
-                                    sc_core::sc_time_stamp().value(), this->regs->getPC());
-                return true;
-            }
-
             /* These operations must be atomical */
             aux = this->regs->getCSR(csr);
             bitmask = this->regs->getValue(rs1);
 
-            this->regs->setValue(rd, aux);
+            if (rd != 0) {
+                this->regs->setValue(rd, aux);
+            }
 
+            /* rs1 == x0 only reads (csrr), the CSR is not written */
             aux2 = aux & ~bitmask;
-            this->regs->setCSR(csr, aux2);
+            if (rs1 != 0) {
+                this->regs->setCSR(csr, aux2);
+            }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. CSRRC: CSR #{:d}(0x{:x}) -> x{:d}(0x{:x}) & CSR #{:d} <- 0x{:x}",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                csr, aux, rd, rs1, csr, aux2);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. CSRRC: CSR #{:d}(0x{:x}) -> x{:d}(0x{:x}) & CSR #{:d} <- 0x{:x}",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    csr, aux, rd, rs1, csr, aux2);
 
             return true;
         }
@@ -1459,9 +1452,9 @@ namespace riscv_tlm {
             aux = rs1;
             this->regs->setCSR(csr, aux);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. CSRRWI: CSR #{:d} -> x{:d}. x{:d} -> CSR #{:d}",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                csr, rd, rs1, csr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. CSRRWI: CSR #{:d} -> x{:d}. x{:d} -> CSR #{:d}",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    csr, rd, rs1, csr);
 
             return true;
         }
@@ -1475,21 +1468,22 @@ namespace riscv_tlm {
             rs1 = this->get_rs1();
             csr = get_csr();
 
-            if (rs1 == 0) {
-                return true;
-            }
-
             /* These operations must be atomical */
             aux = this->regs->getCSR(csr);
-            this->regs->setValue(rd, aux);
+            if (rd != 0) {
+                this->regs->setValue(rd, aux);
+            }
 
+            /* uimm == 0 only reads, the CSR is not written */
             bitmask = rs1;
             aux = aux | bitmask;
-            this->regs->setCSR(csr, aux);
+            if (rs1 != 0) {
+                this->regs->setCSR(csr, aux);
+            }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. CSRRSI: CSR #{:d} -> x{:d}. x{:d} & CSR #{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                csr, rd, rs1, csr, aux);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. CSRRSI: CSR #{:d} -> x{:d}. x{:d} & CSR #{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    csr, rd, rs1, csr, aux);
 
             return true;
         }
@@ -1503,21 +1497,22 @@ namespace riscv_tlm {
             rs1 = this->get_rs1();
             csr = get_csr();
 
-            if (rs1 == 0) {
-                return true;
-            }
-
             /* These operations must be atomical */
             aux = this->regs->getCSR(csr);
-            this->regs->setValue(rd, aux);
+            if (rd != 0) {
+                this->regs->setValue(rd, aux);
+            }
 
+            /* uimm == 0 only reads, the CSR is not written */
             bitmask = rs1;
             aux = aux & ~bitmask;
-            this->regs->setCSR(csr, aux);
+            if (rs1 != 0) {
+                this->regs->setCSR(csr, aux);
+            }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. CSRRCI: CSR #{:d} -> x{:d}. x{:d} & CSR #{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                csr, rd, rs1, csr, aux);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. CSRRCI: CSR #{:d} -> x{:d}. x{:d} & CSR #{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    csr, rd, rs1, csr, aux);
 
             return true;
         }
@@ -1529,8 +1524,8 @@ namespace riscv_tlm {
 
             new_pc = this->regs->getCSR(CSR_MEPC);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. MRET: PC <- 0x{:x}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(), new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. MRET: PC <- 0x{:x}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(), new_pc);
 
             this->regs->setPC(new_pc);
 
@@ -1551,21 +1546,26 @@ namespace riscv_tlm {
 
             new_pc = this->regs->getCSR(CSR_SEPC);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. SRET: PC <- 0x{:x}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(), new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRET: PC <- 0x{:x}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(), new_pc);
 
             this->regs->setPC(new_pc);
 
             return true;
         }
 
-        bool Exec_WFI() const {
-            this->logger->debug("{} ns. PC: 0x{:x}. WFI");
+        bool Exec_WFI() {
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. WFI");
+
+            /* CPU suspends the hart once the instruction is completed */
+            if (wfi_flag != nullptr) {
+                *wfi_flag = true;
+            }
             return true;
         }
 
         bool Exec_SFENCE() const {
-            this->logger->debug("{} ns. PC: 0x{:x}. SFENCE");
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SFENCE");
             return true;
         }
 
@@ -1791,247 +1791,8 @@ namespace riscv_tlm {
             return PC_not_affected;
         }
 
-        /**
-         * @brief Decodes opcode of instruction
-         * @return opcode of instruction
-         */
-        opCodes decode() const {
-            switch (opcode()) {
-                case LUI:
-                    return OP_LUI;
-                case AUIPC:
-                    return OP_AUIPC;
-                case JAL:
-                    return OP_JAL;
-                case JALR:
-                    return OP_JALR;
-                case BEQ:
-                    switch (this->get_funct3()) {
-                        case BEQ_F:
-                            return OP_BEQ;
-                        case BNE_F:
-                            return OP_BNE;
-                        case BLT_F:
-                            return OP_BLT;
-                        case BGE_F:
-                            return OP_BGE;
-                        case BLTU_F:
-                            return OP_BLTU;
-                        case BGEU_F:
-                            return OP_BGEU;
-                    }
-                    return OP_ERROR;
-                case LB:
-                    switch (this->get_funct3()) {
-                        case LB_F:
-                            return OP_LB;
-                        case LH_F:
-                            return OP_LH;
-                        case LW_F:
-                            return OP_LW;
-                        case LBU_F:
-                            return OP_LBU;
-                        case LHU_F:
-                            return OP_LHU;
-                        case LWU_F:
-                            return OP_LWU;
-                        case LD_F:
-                            return OP_LD;
-                    }
-                    return OP_ERROR;
-                case SB:
-                    switch (this->get_funct3()) {
-                        case SB_F:
-                            return OP_SB;
-                        case SH_F:
-                            return OP_SH;
-                        case SW_F:
-                            return OP_SW;
-                        case SD_F:
-                            return OP_SD;
-                    }
-                    return OP_ERROR;
-                case ADDI:
-                    switch (this->get_funct3()) {
-                        case ADDI_F:
-                            return OP_ADDI;
-                        case SLTI_F:
-                            return OP_SLTI;
-                        case SLTIU_F:
-                            return OP_SLTIU;
-                        case XORI_F:
-                            return OP_XORI;
-                        case ORI_F:
-                            return OP_ORI;
-                        case ANDI_F:
-                            return OP_ANDI;
-                        case SLLI_F:
-                            return OP_SLLI;
-                        case SRLI_F:
-                            // TODO: Why funct7b is not working?
-                            //switch (this->get_funct7b()) {
-                            switch(this->m_instr.to_uint() >> 26) {
-                                case SRLI_F7:
-                                    return OP_SRLI;
-                                case SRAI_F7:
-                                    return OP_SRAI;
-                            }
-                            return OP_ERROR;
-                    }
-                    return OP_ERROR;
-                case ADD: {
-                    if ( (this->get_funct7() != 0) && (this->get_funct7() != 0b0100000) ) {
-                        return OP_ERROR;
-                    }
-                    switch (this->get_funct3()) {
-                        case ADD_F:
-                            switch (this->get_funct7()) {
-                                case ADD_F7:
-                                    return OP_ADD;
-                                case SUB_F7:
-                                    return OP_SUB;
-                                default:
-                                    return OP_ERROR;
-                            }
-                            break;
-                        case SLL_F:
-                            return OP_SLL;
-                        case SLT_F:
-                            return OP_SLT;
-                        case SLTU_F:
-                            return OP_SLTU;
-                        case XOR_F:
-                            return OP_XOR;
-                        case SRL_F:
-                            switch (this->get_funct7()) {
-                                case SRL_F7:
-                                    return OP_SRL;
-                                case SRA_F7:
-                                    return OP_SRA;
-                                default:
-                                    return OP_ERROR;
-                            }
-                        case OR_F:
-                            return OP_OR;
-                        case AND_F:
-                            return OP_AND;
-                        default:
-                            return OP_ERROR;
-                    }
-                } /* ADD */
-                case FENCE:
-                    return OP_FENCE;
-                case ECALL: {
-                    switch (this->get_funct3()) {
-                        case ECALL_F3:
-                            switch (this->get_csr()) {
-                                case ECALL_F:
-                                    return OP_ECALL;
-                                case EBREAK_F:
-                                    return OP_EBREAK;
-                                case URET_F:
-                                    return OP_URET;
-                                case SRET_F:
-                                    return OP_SRET;
-                                case MRET_F:
-                                    return OP_MRET;
-                                case WFI_F:
-                                    return OP_WFI;
-                                case SFENCE_F:
-                                    return OP_SFENCE;
-                            }
-                            if (this->m_instr.range(31, 25) == 0b0001001) {
-                                return OP_SFENCE;
-                            }
-                            break;
-                        case CSRRW:
-                            return OP_CSRRW;
-                            break;
-                        case CSRRS:
-                            return OP_CSRRS;
-                            break;
-                        case CSRRC:
-                            return OP_CSRRC;
-                            break;
-                        case CSRRWI:
-                            return OP_CSRRWI;
-                            break;
-                        case CSRRSI:
-                            return OP_CSRRSI;
-                            break;
-                        case CSRRCI:
-                            return OP_CSRRCI;
-                            break;
-                    }
-                }
-                    break;
-                case ADDIW:
-                    switch (this->get_funct3()) {
-                        case ADDIW_F:
-                            return OP_ADDIW;
-                            break;
-                        case SLLIW_F:
-                            return OP_SLLIW;
-                            break;
-                        case SRLIW_F:
-                            switch (this->m_instr.to_uint() >> 26) {
-                                case SRLIW_F7:
-                                    return OP_SRLIW;
-                                    break;
-                                case SRAIW_F7:
-                                    return OP_SRAIW;
-                                    break;
-                                default:
-                                    return OP_ERROR;
-                            }
-                            break;
-                        default:
-                            return OP_ERROR;
-                    }
-                    break;
-                case ADDW:
-                    if ( (this->get_funct7() != 0) && (this->get_funct7() != 0b0100000) ) {
-                        return OP_ERROR;
-                    }
-                    switch (this->get_funct3()) {
-                        case ADDW_F:
-                        switch (this->m_instr.to_uint() >> 26) {
-                            case ADDW_F7:
-                                return OP_ADDW;
-                                break;
-                            case SUBW_F7:
-                                return OP_SUBW;
-                                break;
-                            default:
-                                return OP_ERROR;
-                                break;
-                        }
-                        break;
-                        case SLLW:
-                            return OP_SLLW;
-                            break;
-                        case SRLW:
-                            switch (this->m_instr.to_uint() >> 26) {
-                                case SRLW_F7:
-                                    return OP_SRLW;
-                                    break;
-                                case SRAW_F7:
-                                    return OP_SRAW;
-                                    break;
-                                default:
-                                    return OP_ERROR;
-                                    break;
-                            }
-                        default:
-                            return OP_ERROR;
-                    }
-
-                default:
-                    return OP_ERROR;
-            }
-
-            return OP_ERROR;
-        }
+    private:
+        bool *wfi_flag = nullptr;
     };
 }
 #endif
@@ -0,0 +1,428 @@
+/*!
+ \file BlockCache.h
+ \brief Translated basic blocks cache
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_BLOCKCACHE_H_
+#define INC_BLOCKCACHE_H_
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BASE_ISA.h"
+#include "C_extension.h"
+#include "DecodeCache.h"
+#include "InstrFields.h"
+#include "Performance.h"
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Cache of basic blocks translated to arrays of pre-bound handlers
+     *
+     * A basic block is a run of straight-line instructions ending at the first
+     * control flow instruction (or at MAX_BLOCK_LENGTH instructions). Each
+     * instruction is stored together with the CPU handler for its extension,
+     * so executing a block is a tight loop of indirect calls with no fetch,
+     * decode or per-instruction SystemC wait.
+     *
+     * Blocks are chained: the block that follows a direct branch or jump is
+     * linked to it the first time the branch is taken (or not taken), so the
+     * next transfer skips the hash lookup. Indirect jumps keep the last
+     * target in an inline cache and returns are predicted by a return
+     * address stack. Every link is checked against the actual PC before it
+     * is followed, and all of them go away when the blocks are dropped.
+     *
+     * @tparam CPUType CPU class that owns the handlers
+     */
+    template<typename CPUType>
+    class BlockCache {
+    public:
+        /* Handler executes one instruction, returns true if PC is not affected */
+        using handler_t = bool (CPUType::*)(const decoded_instr &, bool *);
+
+        struct block_op {
+            handler_t handler;
+            decoded_instr instr;
+            unsigned int length;        /**< instruction size, 2 or 4 bytes */
+            unsigned int index;         /**< instructions before it in the block */
+        };
+
+        /* How control leaves a block, selects the prediction used by follow() */
+        typedef enum {
+            EXIT_OTHER,             /**< trap, xRET, WFI: no prediction */
+            EXIT_DIRECT,            /**< branch, direct jump or fall through */
+            EXIT_CALL,              /**< direct jump that writes ra (or t0) */
+            EXIT_INDIRECT,          /**< jump through a register */
+            EXIT_INDIRECT_CALL,     /**< jump through a register that writes ra (or t0) */
+            EXIT_RETURN,            /**< jump through ra (or t0) */
+        } exit_t;
+
+        struct translated_block {
+            std::uint64_t pc;
+            std::vector<block_op> ops;
+            std::uint32_t executions;   /**< times executed, to find hot blocks */
+            void (*native)();           /**< translated code, if any */
+            bool replayable;            /**< can be executed again (JIT check) */
+            bool writes_csrs;           /**< may write CSRs (JIT check) */
+            exit_t exit;
+            std::uint64_t taken_pc;     /**< direct branch or jump target */
+            std::uint64_t next_pc;      /**< address right after the block */
+            translated_block *taken;    /**< link to the block at taken_pc */
+            translated_block *next;     /**< link to the block at next_pc */
+            std::uint64_t target_pc;    /**< inline cache: last indirect target */
+            translated_block *target;   /**< inline cache: block at target_pc */
+        };
+
+        /* Longest block, bounds the IRQ latency */
+        enum {
+            MAX_BLOCK_LENGTH = 64
+        };
+
+        /* Return address stack depth */
+        enum {
+            RAS_ENTRIES = 16
+        };
+
+        /**
+         * @brief Constructor
+         * @param performance statistics, counts link hits and misses
+         */
+        explicit BlockCache(Performance *performance) : perf(performance) {
+        }
+
+        /**
+         * @brief Look for a translated block
+         * @param pc address of the first instruction of the block
+         * @return block or nullptr if it is not translated yet
+         */
+        inline translated_block *lookup(std::uint64_t pc) {
+            auto it = blocks.find(pc);
+
+            if (it == blocks.end()) {
+                return nullptr;
+            }
+            return &it->second;
+        }
+
+        /**
+         * @brief Creates a new empty block, to be filled by the CPU
+         * @param pc address of the first instruction of the block
+         * @return the new block
+         */
+        translated_block *create(std::uint64_t pc) {
+            translated_block &block = blocks[pc];
+
+            block.pc = pc;
+            block.ops.clear();
+            block.ops.reserve(8);
+            block.executions = 0;
+            block.native = nullptr;
+            block.replayable = false;
+            block.writes_csrs = true;
+            block.exit = EXIT_OTHER;
+            block.taken_pc = pc;
+            block.next_pc = pc;
+            block.taken = nullptr;
+            block.next = nullptr;
+            block.target_pc = 0;
+            block.target = nullptr;
+
+            return &block;
+        }
+
+        /**
+         * @brief Sets how control leaves a block, once all its instructions are in
+         * @param block block filled by the CPU
+         */
+        void finish(translated_block *block) {
+            const block_op &last = block->ops.back();
+            const decoded_instr &entry = last.instr;
+            std::uint32_t instr = entry.instr;
+
+            block->next_pc = entry.pc + last.length;
+            block->taken_pc = block->next_pc;
+            block->exit = EXIT_DIRECT;
+
+            if (entry.extension == BASE_EXTENSION) {
+                switch (static_cast<opCodes>(entry.code)) {
+                    case OP_JAL:
+                        block->taken_pc = entry.pc + fields::imm_J(instr);
+                        block->exit = is_link(fields::rd(instr)) ? EXIT_CALL : EXIT_DIRECT;
+                        break;
+                    case OP_JALR:
+                        if (is_link(fields::rd(instr))) {
+                            block->exit = EXIT_INDIRECT_CALL;
+                        } else if (is_link(fields::rs1(instr))) {
+                            block->exit = EXIT_RETURN;
+                        } else {
+                            block->exit = EXIT_INDIRECT;
+                        }
+                        break;
+                    case OP_BEQ:
+                    case OP_BNE:
+                    case OP_BLT:
+                    case OP_BGE:
+                    case OP_BLTU:
+                    case OP_BGEU:
+                        block->taken_pc = entry.pc + fields::imm_B(instr);
+                        break;
+                    case OP_ECALL:
+                    case OP_EBREAK:
+                    case OP_MRET:
+                    case OP_SRET:
+                    case OP_WFI:
+                        block->exit = EXIT_OTHER;
+                        break;
+                    default:
+                        break;
+                }
+            } else if (entry.extension == C_EXTENSION) {
+                switch (static_cast<op_C_Codes>(entry.code)) {
+                    case OP_C_JAL:
+                        block->taken_pc = entry.pc + fields::c_imm_J(instr);
+                        block->exit = EXIT_CALL;
+                        break;
+                    case OP_C_J:
+                        block->taken_pc = entry.pc + fields::c_imm_J(instr);
+                        break;
+                    case OP_C_BEQZ:
+                    case OP_C_BNEZ:
+                        block->taken_pc = entry.pc + fields::c_imm_CB(instr);
+                        break;
+                    case OP_C_JR:
+                        block->exit = is_link(fields::c_rs1(instr)) ? EXIT_RETURN : EXIT_INDIRECT;
+                        break;
+                    case OP_C_JALR:
+                        block->exit = EXIT_INDIRECT_CALL;
+                        break;
+                    case OP_C_EBREAK:
+                        block->exit = EXIT_OTHER;
+                        break;
+                    default:
+                        break;
+                }
+            } else if ((entry.extension != M_EXTENSION) && (entry.extension != A_EXTENSION)) {
+                block->exit = EXIT_OTHER;
+            }
+        }
+
+        /**
+         * @brief Look for the block that runs after the last one entered
+         *
+         * Tries the links of the last block first and falls back to lookup().
+         * When the block is missing, the link is patched by enter() once the
+         * CPU has translated it.
+         *
+         * @param pc address of the next instruction
+         * @return block or nullptr if it is not translated yet
+         */
+        translated_block *follow(std::uint64_t pc) {
+            translated_block *from = last;
+
+            pending = nullptr;
+            if (from == nullptr) {
+                return lookup(pc);
+            }
+
+            switch (from->exit) {
+                case EXIT_CALL:
+                    push(from);
+                    [[fallthrough]];
+                case EXIT_DIRECT:
+                    if (pc == from->taken_pc) {
+                        return chain(&from->taken, pc);
+                    }
+                    if (pc == from->next_pc) {
+                        return chain(&from->next, pc);
+                    }
+                    /* Exception or interrupt */
+                    perf->blockLinkMiss();
+                    break;
+                case EXIT_INDIRECT_CALL:
+                    push(from);
+                    [[fallthrough]];
+                case EXIT_INDIRECT:
+                    if ((from->target != nullptr) && (from->target_pc == pc)) {
+                        perf->indirectHit();
+                        return from->target;
+                    }
+                    perf->indirectMiss();
+                    from->target_pc = pc;
+                    from->target = nullptr;
+                    return resolve(&from->target, pc);
+                case EXIT_RETURN:
+                    if ((ras_depth != 0) && (ras[ras_top].pc == pc)) {
+                        translated_block **slot = ras[ras_top].slot;
+                        pop();
+                        perf->returnHit();
+                        return resolve(slot, pc);
+                    }
+                    if (ras_depth != 0) {
+                        pop();
+                    }
+                    perf->returnMiss();
+                    break;
+                default:
+                    break;
+            }
+
+            return lookup(pc);
+        }
+
+        /**
+         * @brief Called before a block runs, completes the link left by follow()
+         * @param block block about to run
+         */
+        inline void enter(translated_block *block) {
+            if (pending != nullptr) {
+                *pending = block;
+                pending = nullptr;
+            }
+            last = block;
+        }
+
+        /**
+         * @brief Drop all blocks if code memory has been written since last check
+         * @param code_generation current DecodeCache generation
+         * @return true if blocks were dropped
+         */
+        inline bool sync(std::uint64_t code_generation) {
+            if (code_generation == generation) {
+                return false;
+            }
+            /* Links, inline caches and the return stack point into the dropped blocks */
+            blocks.clear();
+            last = nullptr;
+            pending = nullptr;
+            ras_depth = 0;
+            generation = code_generation;
+            return true;
+        }
+
+        /**
+         * @brief Checks if an instruction must be the last one of a block
+         * @param entry decoded instruction
+         * @return true if instruction changes control flow
+         */
+        static bool ends_block(const decoded_instr &entry) {
+            switch (entry.extension) {
+                case BASE_EXTENSION:
+                    switch (static_cast<opCodes>(entry.code)) {
+                        case OP_JAL:
+                        case OP_JALR:
+                        case OP_BEQ:
+                        case OP_BNE:
+                        case OP_BLT:
+                        case OP_BGE:
+                        case OP_BLTU:
+                        case OP_BGEU:
+                        case OP_ECALL:
+                        case OP_EBREAK:
+                        case OP_MRET:
+                        case OP_SRET:
+                        case OP_WFI:
+                        case OP_FENCE:
+                        /* CSR writes may enable pending interrupts */
+                        case OP_CSRRW:
+                        case OP_CSRRS:
+                        case OP_CSRRC:
+                        case OP_CSRRWI:
+                        case OP_CSRRSI:
+                        case OP_CSRRCI:
+                            return true;
+                        default:
+                            return false;
+                    }
+                case C_EXTENSION:
+                    switch (static_cast<op_C_Codes>(entry.code)) {
+                        case OP_C_JAL:
+                        case OP_C_J:
+                        case OP_C_JR:
+                        case OP_C_JALR:
+                        case OP_C_BEQZ:
+                        case OP_C_BNEZ:
+                        case OP_C_EBREAK:
+                            return true;
+                        default:
+                            return false;
+                    }
+                case M_EXTENSION:
+                case A_EXTENSION:
+                    return false;
+                default:
+                    return true;
+            }
+        }
+
+    private:
+        struct return_entry {
+            std::uint64_t pc;           /**< return address */
+            translated_block **slot;    /**< caller link to the block at pc */
+        };
+
+        /**
+         * @brief ra (x1) or t0 (x5), the link registers of the calling convention
+         */
+        static bool is_link(std::uint32_t reg) {
+            return (reg == 1) || (reg == 5);
+        }
+
+        /**
+         * @brief Follows a direct link, or sets it up
+         */
+        translated_block *chain(translated_block **slot, std::uint64_t pc) {
+            if (*slot != nullptr) {
+                perf->blockLinkHit();
+                return *slot;
+            }
+            perf->blockLinkMiss();
+            return resolve(slot, pc);
+        }
+
+        /**
+         * @brief Block linked by slot, filled from lookup() or left to enter()
+         */
+        translated_block *resolve(translated_block **slot, std::uint64_t pc) {
+            if (*slot == nullptr) {
+                *slot = lookup(pc);
+                if (*slot == nullptr) {
+                    pending = slot;
+                }
+            }
+            return *slot;
+        }
+
+        /**
+         * @brief Pushes the return address of a call block, drops the oldest entry when full
+         */
+        void push(translated_block *caller) {
+            ras_top = (ras_top + 1) % RAS_ENTRIES;
+            ras[ras_top] = {caller->next_pc, &caller->next};
+            if (ras_depth < RAS_ENTRIES) {
+                ras_depth++;
+            }
+        }
+
+        void pop() {
+            ras_top = (ras_top + RAS_ENTRIES - 1) % RAS_ENTRIES;
+            ras_depth--;
+        }
+
+        std::unordered_map<std::uint64_t, translated_block> blocks;
+        std::uint64_t generation = 0;
+        Performance *perf;
+        translated_block *last = nullptr;       /**< block entered last */
+        translated_block **pending = nullptr;   /**< link to patch in enter() */
+        std::array<return_entry, RAS_ENTRIES> ras{};
+        unsigned int ras_top = 0;
+        unsigned int ras_depth = 0;
+    };
+}
+
+#endif /* INC_BLOCKCACHE_H_ */
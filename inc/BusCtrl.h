@@ -9,14 +9,19 @@
 #ifndef __BUSCTRL_H__
 #define __BUSCTRL_H__
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #define SC_INCLUDE_DYNAMIC_PROCESSES
 
 #include "systemc"
 
 #include "tlm.h"
+#include "tlm_utils/multi_passthrough_initiator_socket.h"
 #include "tlm_utils/simple_initiator_socket.h"
 #include "tlm_utils/simple_target_socket.h"
 
@@ -39,9 +44,11 @@ namespace riscv_tlm {
  *
  * This module manages instructon & data bus. It has 2 target ports,
  * cpu_instr_socket and cpu_data_socket that receives accesses from CPU and
- * has 2 initiator ports to access main Memory and Trace module.
- * It will be expanded with more ports when required (for DMA,
- * other peripherals, etc.)
+ * one multi initiator port to access all devices (main Memory, Trace,
+ * Timer...). Each device is mapped to an address range with
+ * register_target() and receives accesses with absolute addresses.
+ * Accesses to unmapped addresses at or above TO_HOST_ADDRESS stop the
+ * simulation.
  */
     class BusCtrl : sc_core::sc_module {
     public:
@@ -56,19 +63,9 @@ namespace riscv_tlm {
         tlm_utils::simple_target_socket<BusCtrl> cpu_data_socket;
 
         /**
-         * @brief TLM initiator socket Main memory bus
+         * @brief TLM initiator socket to devices, bound by register_target()
          */
-        tlm_utils::simple_initiator_socket<BusCtrl> memory_socket;
-
-        /**
-         * @brief TLM initiator socket Trace module
-         */
-        tlm_utils::simple_initiator_socket<BusCtrl> trace_socket;
-
-        /**
-         * @brief TLM initiator socket Trace module
-         */
-        tlm_utils::simple_initiator_socket<BusCtrl> timer_socket;
+        tlm_utils::multi_passthrough_initiator_socket<BusCtrl> target_socket;
 
         /**
          * @brief constructor
@@ -76,6 +73,18 @@ namespace riscv_tlm {
          */
         explicit BusCtrl(sc_core::sc_module_name const &name);
 
+        /**
+         * @brief Binds a device and maps it in the address space, must be
+         * called before the simulation starts
+         * @param name device name
+         * @param socket device target socket
+         * @param base first address of the device
+         * @param size size of the address range in bytes
+         * @param dmi device may grant DMI for this range
+         */
+        void register_target(const std::string &name, tlm::tlm_target_socket<> &socket,
+                             std::uint64_t base, std::uint64_t size, bool dmi);
+
         /**
          * @brief TLM-2 blocking mechanism
          * @param trans transtractino to perform
@@ -85,10 +94,55 @@ namespace riscv_tlm {
                                  sc_core::sc_time &delay);
 
     private:
-        bool instr_direct_mem_ptr(tlm::tlm_generic_payload &,
-                                  tlm::tlm_dmi &dmi_data);
+        /**
+         * @brief Device mapped in the bus
+         */
+        struct bus_target {
+            std::string name;
+            std::uint64_t start;    /**< first address */
+            std::uint64_t end;      /**< last address */
+            int socket_id;          /**< target_socket index */
+            bool dmi;
+        };
+
+        /**
+         * @brief Look for the device mapped at an address
+         * @param addr address to look for
+         * @return device or nullptr if address is not mapped
+         */
+        inline const bus_target *find_target(std::uint64_t addr) {
+            /* Most accesses go to the same device (RAM) than the previous one */
+            if ((last_target != nullptr) && (addr >= last_target->start) && (addr <= last_target->end)) {
+                return last_target;
+            }
+
+            auto it = std::upper_bound(targets.begin(), targets.end(), addr,
+                                       [](std::uint64_t a, const bus_target &t) { return a < t.start; });
+            if ((it == targets.begin()) || (addr > (--it)->end)) {
+                return nullptr;
+            }
+
+            last_target = &(*it);
+            return last_target;
+        }
+
+        /**
+         * @brief Forward DMI requests to the device, if it is DMI capable
+         * @param trans transaction asking for DMI
+         * @param dmi_data DMI region granted
+         * @return true if DMI is granted
+         */
+        bool direct_mem_ptr(tlm::tlm_generic_payload &trans,
+                            tlm::tlm_dmi &dmi_data);
+
+        void invalidate_direct_mem_ptr(int id, sc_dt::uint64 start, sc_dt::uint64 end);
 
-        void invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end);
+        /**
+         * @brief Devices sorted by address
+         */
+        std::vector<bus_target> targets;
+        const bus_target *last_target;
+        int bound_targets;
     };
 }
 #endif
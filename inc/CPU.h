@@ -11,22 +11,42 @@
 
 #define SC_INCLUDE_DYNAMIC_PROCESSES
 
+#include <string>
+#include <type_traits>
+
 #include "systemc"
 #include "tlm.h"
 #include "tlm_utils/simple_initiator_socket.h"
 #include "tlm_utils/simple_target_socket.h"
 
 #include "BASE_ISA.h"
+#include "BlockCache.h"
 #include "C_extension.h"
 #include "M_extension.h"
 #include "A_extension.h"
+#include "DecodeCache.h"
+#include "Decoder.h"
+#include "Fusion.h"
+#include "InstrLog.h"
+#include "JIT.h"
 #include "MemoryInterface.h"
 #include "Performance.h"
 #include "Registers.h"
 
 namespace riscv_tlm {
 
-    typedef enum {RV32, RV64} cpu_types_t;
+    /**
+     * @brief Core configurations, selected with -R
+     */
+    typedef enum {RV32I, RV32IMAC, RV64IMAC} cpu_types_t;
+
+    /**
+     * @brief Execution engine: one instruction per step or whole basic blocks
+     */
+    typedef enum {INTERPRETER, BLOCK} exec_mode_t;
+
+/* Exception code field of the cause sent through the IRQ line */
+#define IRQ_CAUSE_MASK (0x3F)
 
 
     class CPU : sc_core::sc_module  {
@@ -50,6 +70,58 @@ namespace riscv_tlm {
          */
         virtual bool CPU_step() = 0;
 
+        /**
+         * @brief Perform one instruction step, or two if the instruction
+         * heads a fused pair (see setFusion)
+         * @return number of instructions executed
+         */
+        virtual unsigned int CPU_fused_step() = 0;
+
+        /**
+         * @brief Execute one basic block, and the blocks chained to it
+         * @return number of instructions executed
+         */
+        virtual unsigned int CPU_block() = 0;
+
+        /**
+         * @brief Select the execution engine used by CPU_thread
+         * @param mode INTERPRETER or BLOCK
+         */
+        void setExecMode(exec_mode_t mode) { exec_mode = mode; }
+
+        /**
+         * @brief Execute common instruction pairs (lui + addi, auipc + jalr...)
+         * in a single interpreter step. IRQs are taken after the pair.
+         * @param enable true to fuse pairs decoded from now on
+         */
+        void setFusion(bool enable) { fusion_enabled = enable; }
+
+        /**
+         * @brief Translate hot blocks to native code, selects BLOCK mode
+         * @param check execute translated blocks also in the interpreter and
+         * compare the results (differential test)
+         */
+        virtual void enableJIT(bool check) = 0;
+
+        /**
+         * @brief Timing model of the mcycle counter
+         * @param cpi cycles counted for each retired instruction
+         */
+        virtual void setCyclesPerInstruction(unsigned int cpi) = 0;
+
+        /**
+         * @brief Enable temporal decoupling
+         *
+         * CPU runs ahead of SystemC time up to quantum before yielding.
+         * Accesses through the bus (MMIO) and taken interrupts force a sync,
+         * so peripherals see the right time and IRQs are taken at most one
+         * quantum late.
+         *
+         * @param quantum maximum local time, SC_ZERO_TIME to yield after
+         * every instruction (or block)
+         */
+        void setQuantum(const sc_core::sc_time &quantum);
+
         /**
          * @brief Instruction Memory bus socket
          * @param trans transction to perfoem
@@ -76,6 +148,29 @@ namespace riscv_tlm {
         */
         [[noreturn]] void CPU_thread();
 
+        /**
+         * @brief Execute one instruction or one block (see setExecMode) and
+         * take pending IRQs. Used by CPU_thread and by the fast mode loop
+         * @param irq_taken set to true if an IRQ was taken
+         * @return number of instructions executed
+         */
+        unsigned int CPU_execute(bool *irq_taken);
+
+        /**
+         * @brief Time taken by one instruction
+         */
+        const sc_core::sc_time &getInstructionTime() const { return default_time; }
+
+        /**
+         * @brief Suspend the hart (WFI) until an interrupt is pending
+         *
+         * In SystemC mode the CPU thread waits for irq_event. In fast mode
+         * time jumps to the next event of the FastScheduler, until one of
+         * them raises an interrupt. If nothing can wake the hart anymore
+         * the simulation stops.
+         */
+        void wait_for_interrupt();
+
         /**
          * @brief Process and triggers IRQ if all conditions met
          * @return true if IRQ is triggered, false otherwise
@@ -95,28 +190,143 @@ namespace riscv_tlm {
         virtual std::uint64_t getStartDumpAddress() = 0;
         virtual std::uint64_t getEndDumpAddress() = 0;
 
+        /**
+         * @brief Write registers and IRQ state to a checkpoint
+         * @param out checkpoint stream
+         */
+        virtual void saveState(std::ostream &out) = 0;
+
+        /**
+         * @brief Read state written by saveState()
+         * @param in checkpoint stream
+         * @return false if checkpoint was taken with a different CPU
+         */
+        virtual bool restoreState(std::istream &in) = 0;
+
+        /**
+         * @brief Statistics of this hart
+         */
+        const Performance *getPerformance() const { return perf; }
+
+        /**
+         * @brief Write every executed instruction to a binary commit trace
+         * (only if built with ENABLE_INSTR_LOG)
+         * @param filename trace file name, empty to flush and close the
+         * current trace
+         * @param codec block compression, see InstrLog::codecAvailable()
+         * @return false if the trace is not compiled in or the file cannot
+         * be created
+         */
+        virtual bool setInstrLog(const std::string &filename, trace::codec_t codec) = 0;
+
+        /* Debugger access to the hart state, values zero extended to 64 bits */
+        virtual unsigned int getXLEN() const = 0;
+        virtual std::uint64_t getRegister(unsigned int reg) = 0;
+        virtual void setRegister(unsigned int reg, std::uint64_t value) = 0;
+        virtual std::uint64_t getPC() = 0;
+        virtual std::uint64_t getCSR(unsigned int csr) = 0;
+
     public:
         MemoryInterface *mem_intf;
     protected:
+        /**
+         * @brief Highest priority interrupt (MEI, MSI, MTI, SEI, SSI, STI)
+         * @param pending pending and enabled interrupts, not 0
+         * @return exception code of the interrupt, also its MIP bit
+         */
+        static unsigned int irq_cause(std::uint64_t pending);
+
+        /**
+         * @brief Per opcode class statistics of a base ISA instruction
+         * @param code opCodes value
+         * @param PC_not_affected false if a branch was taken
+         */
+        void count_base(std::uint32_t code, bool PC_not_affected);
+
+        /**
+         * @brief Per opcode class statistics of a C extension instruction
+         * @param code op_C_Codes value
+         * @param PC_not_affected false if a branch was taken
+         */
+        void count_c(std::uint32_t code, bool PC_not_affected);
+
+        /**
+         * @brief Create the commit trace and attach it to the memory interface
+         * @param filename trace file name
+         * @param xlen 32 or 64
+         * @param codec block compression
+         * @return false if the trace is not compiled in or the file cannot
+         * be created
+         */
+        bool open_instr_log(const std::string &filename, unsigned int xlen, trace::codec_t codec);
+
+        /**
+         * @brief Add an executed instruction to the commit trace, if enabled.
+         * Called once the instruction is completed
+         */
+        inline void trace_instr(const decoded_instr &entry) {
+            if constexpr (InstrLog::enabled) {
+                if (instr_log != nullptr) {
+                    instr_log->commit(entry.pc, entry.instr, (entry.extension == C_EXTENSION) ? 2 : 4);
+                }
+            }
+        }
+
         Performance *perf;
+        InstrLog *instr_log = nullptr;
         std::shared_ptr<spdlog::logger> logger;
         tlm_utils::tlm_quantumkeeper *m_qk;
+        bool use_qk;
         Instruction inst;
-        bool interrupt;
-        bool irq_already_down;
+        DecodeCache *decode_cache;
+        Decoder *decoder = nullptr;     /**< created by the derived class, depends on the ISA */
+        exec_mode_t exec_mode;
+        bool fusion_enabled = false;
+        bool jit_check;
+        bool interrupt;                 /**< a source raised an IRQ not taken yet */
+        bool wfi_request;               /**< set by WFI, hart sleeps after the current step */
+        sc_core::sc_event irq_event;    /**< notified by call_interrupt() */
         sc_core::sc_time default_time;
         bool dmi_ptr_valid;
         tlm::tlm_generic_payload trans;
         unsigned char *dmi_ptr = nullptr;
+        std::uint64_t dmi_start = 0;    /**< first address covered by dmi_ptr */
+        std::uint64_t dmi_end = 0;      /**< last address covered by dmi_ptr */
     };
 
     /**
-     * @brief RISC_V CPU 32 bits model
-     * @param name name of the module
+     * @brief Placeholder member for an extension left out of a core
      */
-    class CPURV32 : public CPU {
+    struct no_extension {
+        template<typename... Args>
+        explicit no_extension(Args &&...) {}
+    };
+
+    /**
+     * @brief RISC-V core for a given XLEN and set of extensions
+     *
+     * The base ISA is always included. Extensions not in the list are not
+     * decoded (their instructions are unknown) and none of their code is
+     * compiled in, so an RV32I core only dispatches base instructions and
+     * the step loop can be inlined. Extensions are members of the core, not
+     * objects reached through pointers.
+     *
+     * The cores selected by -R are explicitly instantiated in CPUCore.cpp,
+     * see the CPURV32I, CPURV32IMAC and CPURV64IMAC aliases.
+     *
+     * @tparam XLEN 32 or 64
+     * @tparam Extensions any of M_EXTENSION, A_EXTENSION and C_EXTENSION
+     */
+    template<unsigned int XLEN, extension_t... Extensions>
+    class CPUCore : public CPU {
     public:
-        using BaseType = std::uint32_t;
+        static_assert((XLEN == 32) || (XLEN == 64), "XLEN must be 32 or 64");
+
+        using BaseType = std::conditional_t<XLEN == 32, std::uint32_t, std::uint64_t>;
+
+        static constexpr bool has_m = ((Extensions == M_EXTENSION) || ...);
+        static constexpr bool has_a = ((Extensions == A_EXTENSION) || ...);
+        static constexpr bool has_c = ((Extensions == C_EXTENSION) || ...);
 
         /**
          * @brief Constructor
@@ -124,78 +334,159 @@ namespace riscv_tlm {
          * @param PC   Program Counter initialize value
          * @param debug To start debugging
          */
-        CPURV32(sc_core::sc_module_name const &name, BaseType PC, bool debug);
+        CPUCore(sc_core::sc_module_name const &name, BaseType PC, bool debug);
 
         /**
          * @brief Destructor
          */
-        ~CPURV32() override;
+        ~CPUCore() override;
 
         bool CPU_step() override;
-        Registers<BaseType> *getRegisterBank() { return register_bank; }
+        unsigned int CPU_fused_step() override;
+        unsigned int CPU_block() override;
+        void enableJIT(bool check) override;
+        void setCyclesPerInstruction(unsigned int cpi) override { register_bank.setCyclesPerInstruction(cpi); }
+        bool setInstrLog(const std::string &filename, trace::codec_t codec) override;
+        Registers<BaseType> *getRegisterBank() { return &register_bank; }
+
+        unsigned int getXLEN() const override { return XLEN; }
+        std::uint64_t getRegister(unsigned int reg) override { return register_bank.getValue(reg); }
+        void setRegister(unsigned int reg, std::uint64_t value) override {
+            register_bank.setValue(reg, static_cast<BaseType>(value));
+        }
+        std::uint64_t getPC() override { return register_bank.getPC(); }
+        std::uint64_t getCSR(unsigned int csr) override { return register_bank.getCSR(csr); }
+
+        /**
+         * @brief ISA string of the core, as in RV32IMAC
+         */
+        static std::string isa_name();
 
     private:
-        Registers<BaseType> *register_bank;
-        C_extension<BaseType> *c_inst;
-        M_extension<BaseType> *m_inst;
-        A_extension<BaseType> *a_inst;
-        BASE_ISA<BaseType> *base_inst;
-        BaseType int_cause;
+        using handler_t = typename BlockCache<CPUCore>::handler_t;
+        using block_t = typename BlockCache<CPUCore>::translated_block;
+
+        template<bool enabled, typename Impl>
+        using extension_member = std::conditional_t<enabled, Impl, no_extension>;
+
+        Registers<BaseType> register_bank;
+        BASE_ISA<BaseType> base_inst;
+        extension_member<has_c, C_extension<BaseType>> c_inst;
+        extension_member<has_m, M_extension<BaseType>> m_inst;
+        extension_member<has_a, A_extension<BaseType>> a_inst;
+        BlockCache<CPUCore> *block_cache;
+        JIT<BaseType> *jit;
+        bool block_breakpoint = false;  /**< ECALL/EBREAK in a block, chaining stops so sc_stop() is seen */
+        unsigned int jit_retired = 0;   /**< instructions of the running native block already retired */
+        Registers<BaseType> *check_initial = nullptr;   /**< JIT check, state before the block */
+        Registers<BaseType> *check_native = nullptr;    /**< JIT check, state after the native run */
         BaseType INSTR;
 
         /**
-         *
-         * @brief Process and triggers IRQ if all conditions met
-         * @return true if IRQ is triggered, false otherwise
+         * @brief Fetch and decode instruction at PC, storing it in the decode cache
+         * @param pc address of the instruction
+         * @return decoded instruction
          */
-        bool cpu_process_IRQ() override;
+        decoded_instr *fetch_decode(BaseType pc);
 
         /**
-         * @brief callback for IRQ simple socket
-         * @param trans transaction to perform (empty)
-         * @param delay time to annotate
-         *
-         * it triggers an IRQ when called
+         * @brief Look for the instruction at PC in the decode cache, fetch and
+         * decode it if it is not there
+         * @param pc address of the instruction
+         * @return decoded instruction
          */
-        void call_interrupt(tlm::tlm_generic_payload &trans,
-                            sc_core::sc_time &delay) override;
+        decoded_instr *lookup_decode(BaseType pc);
 
-        std::uint64_t getStartDumpAddress() override;
-        std::uint64_t getEndDumpAddress() override;
-    }; // RV32 class
+        /**
+         * @brief Pair a new decode cache entry with its neighbours
+         * @param entry instruction just decoded
+         */
+        void fuse(decoded_instr *entry);
 
-    /**
-     * @brief RISC_V CPU 64 bits model
-     * @param name name of the module
-     */
-    class CPURV64 : public CPU {
-    public:
-        using BaseType = std::uint64_t;
+        /**
+         * @brief Execute and retire one instruction
+         * @param entry decoded instruction at PC
+         * @return true if instruction is a breakpoint
+         */
+        bool step(const decoded_instr &entry);
 
         /**
-         * @brief Constructor
-         * @param name Module name
-         * @param PC   Program Counter initialize value
-         * @param debug To start debugging
+         * @brief Execute a fused pair as a single operation: each register is
+         * written once and PC is updated once, to the address after the pair
+         * or to the target of its jump or branch
+         * @param head first instruction of the pair, at PC
+         * @param next second instruction of the pair
+         * @return false if the pair has to run as two steps, nothing is changed then
          */
-        CPURV64(sc_core::sc_module_name const &name, BaseType PC, bool debug);
+        bool exec_fused(const decoded_instr &head, const decoded_instr &next);
 
         /**
-         * @brief Destructor
+         * @brief Execute a decoded instruction of an extension and update PC
+         * @tparam extension extension of the instruction, part of this core
+         * @param entry decoded instruction
+         * @param breakpoint set to true if instruction is a breakpoint
+         * @return true if PC was not affected by the instruction
          */
-        ~CPURV64() override;
+        template<extension_t extension>
+        bool exec(const decoded_instr &entry, bool *breakpoint);
+        bool exec_unknown(const decoded_instr &entry, bool *breakpoint);
 
-        bool CPU_step() override;
-        Registers<BaseType> *getRegisterBank() { return register_bank; }
+        /**
+         * @brief Execute a decoded instruction, dispatching on its extension
+         * @param entry decoded instruction
+         * @param breakpoint set to true if instruction is a breakpoint
+         * @return true if PC was not affected by the instruction
+         */
+        bool execute(const decoded_instr &entry, bool *breakpoint);
 
-    private:
-        Registers<BaseType> *register_bank;
-        C_extension<BaseType> *c_inst;
-        M_extension<BaseType> *m_inst;
-        A_extension<BaseType> *a_inst;
-        BASE_ISA<BaseType> *base_inst;
-        BaseType int_cause;
-        BaseType INSTR;
+        /**
+         * @brief Handler that executes instructions of an extension
+         * @param extension extension returned by the decoder
+         * @return handler
+         */
+        static handler_t handler_for(extension_t extension);
+
+        /**
+         * @brief Build the basic block starting at PC
+         * @param pc address of the first instruction
+         * @return translated block
+         */
+        block_t *translate_block(BaseType pc);
+
+        /**
+         * @brief Find (or translate) the block at PC and execute it
+         * @return number of instructions executed
+         */
+        unsigned int exec_block();
+
+        /**
+         * @brief Execute a block in the interpreter
+         * @param block block to execute
+         * @return number of instructions executed
+         */
+        unsigned int run_block(const block_t *block);
+
+        /**
+         * @brief Translate a hot block to native code
+         * @param block block to translate
+         */
+        void jit_compile(block_t *block);
+
+        /**
+         * @brief Execute a translated block, checking it against the
+         * interpreter if requested
+         * @param block block to execute
+         * @return number of instructions executed
+         */
+        unsigned int jit_run(const block_t *block);
+
+        /**
+         * @brief Interpreter fallback called from native code
+         * @param cpu this CPU
+         * @param arg block_op to execute
+         * @return true if execution of the block can go on
+         */
+        static bool jit_helper(void *cpu, const void *arg);
 
         /**
          *
@@ -216,7 +507,19 @@ namespace riscv_tlm {
 
         std::uint64_t getStartDumpAddress() override;
         std::uint64_t getEndDumpAddress() override;
-    }; // RV64 class
+
+        void saveState(std::ostream &out) override;
+        bool restoreState(std::istream &in) override;
+    }; // CPUCore class
+
+    /* Cores selected by -R, instantiated in CPUCore.cpp */
+    using CPURV32I = CPUCore<32>;
+    using CPURV32IMAC = CPUCore<32, M_EXTENSION, A_EXTENSION, C_EXTENSION>;
+    using CPURV64IMAC = CPUCore<64, M_EXTENSION, A_EXTENSION, C_EXTENSION>;
+
+    extern template class CPUCore<32>;
+    extern template class CPUCore<32, M_EXTENSION, A_EXTENSION, C_EXTENSION>;
+    extern template class CPUCore<64, M_EXTENSION, A_EXTENSION, C_EXTENSION>;
 
 }
 #endif
@@ -113,141 +113,36 @@ namespace riscv_tlm {
         using signed_T = typename std::make_signed<T>::type;
         using unsigned_T = typename std::make_unsigned<T>::type;
 
-        /**
-         * @brief Access to opcode field
-         * @return return opcode field
-         */
-        [[nodiscard]] inline unsigned_T opcode() const override {
-            return static_cast<unsigned_T>(this->m_instr.range(1, 0));
-        }
-
         [[nodiscard]] inline std::uint32_t get_rdp() const {
-            return static_cast<std::uint32_t>(this->m_instr.range(4, 2) + 8);
+            return fields::c_rdp(this->m_instr);
         }
 
         /**
          * @brief Access to rs1 field
          * @return rs1 field
          */
-        [[nodiscard]] inline std::uint32_t get_rs1() const override {
-            return static_cast<std::uint32_t>(this->m_instr.range(11, 7));
-        }
-
-        inline void set_rs1(std::uint32_t value) override {
-            this->m_instr.range(11, 7) = value;
+        [[nodiscard]] inline std::uint32_t get_rs1() const {
+            return fields::c_rs1(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_rs1p() const {
-            return static_cast<std::uint32_t>(this->m_instr.range(9, 7) + 8);
+            return fields::c_rs1p(this->m_instr);
         }
 
         /**
          * @brief Access to rs2 field
          * @return rs2 field
          */
-        [[nodiscard]] inline std::uint32_t get_rs2() const override {
-            return static_cast<std::uint32_t>(this->m_instr.range(6, 2));
-        }
-
-        inline void set_rs2(std::uint32_t value) override {
-            this->m_instr.range(6, 2) = value;
+        [[nodiscard]] inline std::uint32_t get_rs2() const {
+            return fields::c_rs2(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_rs2p() const {
-            return static_cast<std::uint32_t>(this->m_instr.range(4, 2) + 8);
-        }
-
-        [[nodiscard]] inline std::uint32_t get_funct3() const override {
-            return static_cast<std::uint32_t>(this->m_instr.range(15, 13));
-        }
-
-        inline void set_funct3(std::uint32_t value) override {
-            this->m_instr.range(15, 13) = value;
-        }
-
-        /**
-         * @brief Access to immediate field for I-type
-         * @return immediate_I field
-         */
-        [[nodiscard]] inline std::int32_t get_imm_I() const {
-            std::int32_t aux = 0;
-
-            aux = static_cast<std::int32_t>(this->m_instr.range(31, 20));
-
-            /* sign extension (optimize) */
-            if (this->m_instr[31] == 1) {
-                aux |= (0b11111111111111111111) << 12;
-            }
-
-            return aux;
-        }
-
-        inline void set_imm_I(std::uint32_t value) const {
-            this->m_instr.range(31, 20) = value;
-        }
-
-        /**
-         * @brief Access to immediate field for S-type
-         * @return immediate_S field
-         */
-        [[nodiscard]] inline std::int32_t get_imm_S() const {
-            std::int32_t aux = 0;
-
-            aux = static_cast<std::int32_t>(this->m_instr.range(31, 25) << 5);
-            aux |= static_cast<std::int32_t>(this->m_instr.range(11, 7));
-
-            if (this->m_instr[31] == 1) {
-                aux |= (0b11111111111111111111) << 12;
-            }
-
-            return aux;
+            return fields::c_rs2p(this->m_instr);
         }
 
-        inline void set_imm_S(std::uint32_t value) const {
-            sc_dt::sc_uint<32> aux = value;
-
-            this->m_instr.range(31, 25) = aux.range(11, 5);
-            this->m_instr.range(11, 7) = aux.range(4, 0);
-        }
-
-        /**
-         * @brief Access to immediate field for U-type
-         * @return immediate_U field
-         */
-        [[nodiscard]] inline std::uint32_t get_imm_U() const {
-            return static_cast<std::uint32_t>(this->m_instr.range(31, 12));
-        }
-
-        inline void set_imm_U(std::uint32_t value) const {
-            this->m_instr.range(31, 12) = (value << 12);
-        }
-
-        /**
-         * @brief Access to immediate field for B-type
-         * @return immediate_B field
-         */
-        [[nodiscard]] inline std::int32_t get_imm_B() const {
-            std::int32_t aux = 0;
-
-            aux |= static_cast<std::int32_t>(this->m_instr[7] << 11);
-            aux |= static_cast<std::int32_t>(this->m_instr.range(30, 25) << 5);
-            aux |= static_cast<std::int32_t>(this->m_instr[31] << 12);
-            aux |= static_cast<std::int32_t>(this->m_instr.range(11, 8) << 1);
-
-            if (this->m_instr[31] == 1) {
-                aux |= (0b11111111111111111111) << 12;
-            }
-
-            return aux;
-        }
-
-        inline void set_imm_B(std::uint32_t value) const {
-            sc_dt::sc_uint<32> aux = value;
-
-            this->m_instr[31] = aux[12];
-            this->m_instr.range(30, 25) = aux.range(10, 5);
-            this->m_instr.range(11, 7) = aux.range(4, 1);
-            this->m_instr[6] = aux[11];
+        [[nodiscard]] inline std::uint32_t get_funct3() const {
+            return fields::c_funct3(this->m_instr);
         }
 
         /**
@@ -255,337 +150,55 @@ namespace riscv_tlm {
          * @return immediate_J field
          */
         [[nodiscard]] inline std::int32_t get_imm_J() const {
-            std::int32_t aux = 0;
-
-            aux = static_cast<std::int32_t>(this->m_instr[12] << 11);
-            aux |= static_cast<std::int32_t>(this->m_instr[11] << 4);
-            aux |= static_cast<std::int32_t>(this->m_instr[10] << 9);
-            aux |= static_cast<std::int32_t>(this->m_instr[9] << 8);
-            aux |= static_cast<std::int32_t>(this->m_instr[8] << 10);
-            aux |= static_cast<std::int32_t>(this->m_instr[7] << 6);
-            aux |= static_cast<std::int32_t>(this->m_instr[6] << 7);
-            aux |= static_cast<std::int32_t>(this->m_instr.range(5, 3) << 1);
-            aux |= static_cast<std::int32_t>(this->m_instr[2] << 5);
-
-            if (this->m_instr[12] == 1) {
-                aux |= 0b11111111111111111111 << 12;
-            }
-
-            return aux;
-        }
-
-        inline void set_imm_J(std::uint32_t value) const {
-            sc_dt::sc_uint<32> aux = (value << 20);
-
-            this->m_instr[31] = aux[20];
-            this->m_instr.range(30, 21) = aux.range(10, 1);
-            this->m_instr[20] = aux[11];
-            this->m_instr.range(19, 12) = aux.range(19, 12);
+            return fields::c_imm_J(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_L() const {
-            std::uint32_t aux = 0;
-
-            aux = this->m_instr.range(12, 10) << 3;
-            aux |= this->m_instr[6] << 2;
-            aux |= this->m_instr[5] << 6;
-
-            return aux;
+            return fields::c_imm_L(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_LWSP() const {
-            std::uint32_t aux = 0;
-
-            aux = this->m_instr[12] << 5;
-            aux |= this->m_instr.range(6, 4) << 2;
-            aux |= this->m_instr.range(3, 2) << 6;
-
-            return aux;
+            return fields::c_imm_LWSP(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_LDSP() const {
-            std::uint32_t aux = 0;
-
-            aux = static_cast<std::uint32_t>(this->m_instr[12] << 5);
-            aux |= static_cast<std::uint32_t>(this->m_instr.range(6, 5) << 3);
-            aux |= static_cast<std::uint32_t>(this->m_instr.range(4, 2) << 6);
-
-            return aux;
+            return fields::c_imm_LDSP(this->m_instr);
         }
 
         [[nodiscard]] inline std::int32_t get_imm_ADDI() const {
-            std::uint32_t aux = 0;
-
-            aux = static_cast<std::uint32_t>(this->m_instr[12] << 5);
-            aux |= static_cast<std::uint32_t>(this->m_instr.range(6, 2));
+            return fields::c_imm_ADDI(this->m_instr);
+        }
 
-            if (this->m_instr[12] == 1) {
-                aux |= 0b11111111111111111111111111 << 6;
-            }
-            return static_cast<std::int32_t>(aux);
+        [[nodiscard]] inline std::uint32_t get_shamt() const {
+            return fields::c_shamt(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_ADDI4SPN() const {
-            std::uint32_t aux = 0;
-
-            aux = static_cast<std::uint32_t>(this->m_instr.range(12, 11) << 4);
-            aux |= static_cast<std::uint32_t>(this->m_instr.range(10, 7) << 6);
-            aux |= static_cast<std::uint32_t>(this->m_instr[6] << 2);
-            aux |= static_cast<std::uint32_t>(this->m_instr[5] << 3);
-
-            return aux;
+            return fields::c_imm_ADDI4SPN(this->m_instr);
         }
 
         [[nodiscard]] inline std::int32_t get_imm_ADDI16SP() const {
-            std::uint32_t aux = 0;
-
-            aux = static_cast<std::uint32_t>(this->m_instr[12] << 9);
-            aux |= static_cast<std::uint32_t>(this->m_instr[6] << 4);
-            aux |= static_cast<std::uint32_t>(this->m_instr[5] << 6);
-            aux |= static_cast<std::uint32_t>(this->m_instr[4] << 8);
-            aux |= static_cast<std::uint32_t>(this->m_instr[3] << 7);
-            aux |= static_cast<std::uint32_t>(this->m_instr[2] << 5);
-
-            if (this->m_instr[12] == 1) {
-                aux |= 0b1111111111111111111111 << 10;
-            }
-            return aux;
+            return fields::c_imm_ADDI16SP(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_CSS() const {
-            std::uint32_t aux = 0;
-            aux = static_cast<std::uint32_t>(this->m_instr.range(12, 9) << 2);
-            aux |= static_cast<std::uint32_t>(this->m_instr.range(8, 7) << 6);
-
-            return aux;
+            return fields::c_imm_CSS(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_CSDSP() const {
-            std::uint32_t aux = 0;
-            aux = static_cast<std::uint32_t>(this->m_instr.range(12, 10) << 3);
-            aux |= static_cast<std::uint32_t>(this->m_instr.range(9, 7) << 6);
-
-            return aux;
+            return fields::c_imm_CSDSP(this->m_instr);
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_CB() const {
-            std::uint32_t aux = 0;
-
-            aux = static_cast<std::uint32_t>(this->m_instr[12] << 8);
-            aux |= static_cast<std::uint32_t>(this->m_instr[11] << 4);
-            aux |= static_cast<std::uint32_t>(this->m_instr[10] << 3);
-            aux |= static_cast<std::uint32_t>(this->m_instr[6] << 7);
-            aux |= static_cast<std::uint32_t>(this->m_instr[5] << 6);
-            aux |= static_cast<std::uint32_t>(this->m_instr[4] << 2);
-            aux |= static_cast<std::uint32_t>(this->m_instr[3] << 1);
-            aux |= static_cast<std::uint32_t>(this->m_instr[2] << 5);
-
-            if (this->m_instr[12] == 1) {
-                aux |= 0b11111111111111111111111 << 9;
-            }
-
-            return aux;
+            return static_cast<std::uint32_t>(fields::c_imm_CB(this->m_instr));
         }
 
         [[nodiscard]] inline std::uint32_t get_imm_CL() const {
-            std::uint32_t aux = 0;
-
-            aux = this->m_instr.range(12, 10) << 3;
-            aux |= this->m_instr.range(6, 5) << 6;
-
-            return aux;
+            return fields::c_imm_CL(this->m_instr);
         }
 
         [[nodiscard]] inline std::int32_t get_imm_LUI() const {
-            std::int32_t aux = 0;
-
-            aux = this->m_instr[12] << 17;
-            aux |= this->m_instr.range(6, 2) << 12;
-
-            if (this->m_instr[12] == 1) {
-                aux |= 0b111111111111111 << 17;
-            }
-
-            return aux;
-        }
-
-        [[nodiscard]] inline std::uint32_t get_csr() const {
-            return get_imm_I();
-        }
-
-        /**
-         * @brief Decodes opcode of instruction
-         * @return opcode of instruction
-         */
-        [[nodiscard]] op_C_Codes decode() const {
-
-            switch (opcode()) {
-
-                case 0b00:
-                    switch (get_funct3()) {
-                        case C_ADDI4SPN:
-                            return OP_C_ADDI4SPN;
-                            break;
-                        case C_FLD:
-                            return OP_C_FLD;
-                            break;
-                        case C_LW:
-                            return OP_C_LW;
-                            break;
-                        case C_FLW:
-                            if (sizeof(signed_T) == 4) {
-                                // RV32
-                                return OP_C_FLW;
-                            } else {
-                                // RV64
-                                return OP_C_LD;
-                            }
-                            break;
-                        case C_FSD:
-                            return OP_C_FSD;
-                            break;
-                        case C_SW:
-                            return OP_C_SW;
-                            break;
-                        case C_FSW:
-                            if (sizeof(signed_T) == 4) {
-                                return OP_C_FSW;
-                            } else {
-                                return OP_C_SD;
-                            }
-                            break;
-                            [[unlikely]] default:
-                            return OP_C_ERROR;
-                            break;
-                    }
-                    break;
-
-                case 0b01:
-                    switch (get_funct3()) {
-                        case C_ADDI:
-                            return OP_C_ADDI;
-                            break;
-                        case C_JAL:
-                            if (sizeof(signed_T) == 4) {
-                                return OP_C_JAL;
-                            } else {
-                                return OP_C_ADDIW;
-                            }
-                            break;
-                        case C_LI:
-                            return OP_C_LI;
-                            break;
-                        case C_ADDI16SP:
-                            return OP_C_ADDI16SP;
-                            break;
-                        case C_SRLI:
-                            switch (this->m_instr.range(11, 10)) {
-                                case C_2_SRLI:
-                                    return OP_C_SRLI;
-                                    break;
-                                case C_2_SRAI:
-                                    return OP_C_SRAI;
-                                    break;
-                                case C_2_ANDI:
-                                    return OP_C_ANDI;
-                                    break;
-                                case C_2_SUB:
-                                    switch (this->m_instr.range(6, 5)) {
-                                        case C_3_SUB:
-                                            if (this->m_instr[12] == 0) {
-                                                return OP_C_SUB;
-                                            } else {
-                                                return OP_C_SUBW;
-                                            }
-                                            break;
-                                        case C_3_XOR:
-                                            if (this->m_instr[12] == 0) {
-                                                return OP_C_XOR;
-                                            } else {
-                                                return OP_C_ADDW;
-                                            }
-                                            break;
-                                        case C_3_OR:
-                                            return OP_C_OR;
-                                            break;
-                                        case C_3_AND:
-                                            return OP_C_AND;
-                                            break;
-                                    }
-                            }
-                            break;
-                        case C_J:
-                            return OP_C_J;
-                            break;
-                        case C_BEQZ:
-                            return OP_C_BEQZ;
-                            break;
-                        case C_BNEZ:
-                            return OP_C_BNEZ;
-                            break;
-                            [[unlikely]] default:
-                            return OP_C_ERROR;
-                            break;
-                    }
-                    break;
-
-                case 0b10:
-                    switch (get_funct3()) {
-                        case C_SLLI:
-                            return OP_C_SLLI;
-                            break;
-                        case C_FLDSP:
-                        case C_LWSP:
-                            return OP_C_LWSP;
-                            break;
-                        case C_FLWSP:
-                            if (sizeof(signed_T) == 4) {
-                                return OP_C_FLWSP;
-                            } else {
-                                return OP_C_LDSP;
-                            }
-                            break;
-                        case C_JR:
-                            if (this->m_instr[12] == 0) {
-                                if (this->m_instr.range(6, 2) == 0) {
-                                    return OP_C_JR;
-                                } else {
-                                    return OP_C_MV;
-                                }
-                            } else {
-                                if (this->m_instr.range(11, 2) == 0) {
-                                    return OP_C_EBREAK;
-                                } else if (this->m_instr.range(6, 2) == 0) {
-                                    return OP_C_JALR;
-                                } else {
-                                    return OP_C_ADD;
-                                }
-                            }
-                            break;
-                        case C_FDSP:
-                            break;
-                        case C_SWSP:
-                            return OP_C_SWSP;
-                            break;
-                        case C_FWWSP:
-                            if (sizeof(signed_T) == 4) {
-                                return OP_C_FSWSP;
-                            } else {
-                                return OP_C_SDSP;
-                            }
-                            break;
-                        default:
-                            return OP_C_ERROR;
-                            break;
-                    }
-                    break;
-
-                    [[unlikely]] default:
-
-                    return OP_C_ERROR;
-                    break;
-            }
-            return OP_C_ERROR;
+            return fields::c_imm_LUI(this->m_instr);
         }
 
         // PASS
@@ -601,8 +214,8 @@ namespace riscv_tlm {
                     static_cast<unsigned_T>((this->regs->getValue(rs1)) + static_cast<unsigned_T>(mem_addr)) &
                     0xFFFFFFFE);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.JR: PC <- 0x{:x}. x{:d}(0x{:x})", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(), new_pc, rs1, this->regs->getValue(rs1));
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.JR: PC <- 0x{:x}. x{:d}(0x{:x})", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(), new_pc, rs1, this->regs->getValue(rs1));
 
             this->regs->setPC(new_pc);
 
@@ -619,9 +232,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.MV: x{:d}(0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs2, this->regs->getValue(rs2), rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.MV: x{:d}(0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs2, this->regs->getValue(rs2), rd, calc);
 
             return true;
         }
@@ -637,10 +250,10 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) + this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.ADD: x{:d} + x{} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.ADD: x{:d} + x{} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -665,9 +278,9 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.LWSP: x{:d} + {:d}(@0x{:x}) -> x{:d}({:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs1, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.LWSP: x{:d} + {:d}(@0x{:x}) -> x{:d}({:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd, data);
 
             return true;
         }
@@ -689,9 +302,9 @@ namespace riscv_tlm {
             calc = static_cast<signed_T>(this->regs->getValue(rs1)) + imm;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.ADDI4SN: x{:d} + (0x{:x}) + {:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs1, this->regs->getValue(rs1), imm, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.ADDI4SN: x{:d} + (0x{:x}) + {:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs1, this->regs->getValue(rs1), imm, rd, calc);
 
             return true;
         }
@@ -710,18 +323,18 @@ namespace riscv_tlm {
                 calc = this->regs->getValue(rs1) + imm;
                 this->regs->setValue(rd, calc);
 
-                this->logger->debug("{} ns. PC: 0x{:x}. C.ADDI16SP: x{:d} + {:d} -> x{:d} (0x{:x})",
-                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                    rs1, imm, rd, calc);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.ADDI16SP: x{:d} + {:d} -> x{:d} (0x{:x})",
+                                        sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                        rs1, imm, rd, calc);
             } else {
                 /* C.LUI OPCODE */
                 rd = this->get_rd();
                 imm = get_imm_LUI();
                 this->regs->setValue(rd, imm);
 
-                this->logger->debug("{} ns. PC: 0x{:x}. C.LUI: x{:d} <- 0x{:x}", sc_core::sc_time_stamp().value(),
-                                    this->regs->getPC(),
-                                    rd, imm);
+                LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.LUI: x{:d} <- 0x{:x}", sc_core::sc_time_stamp().value(),
+                                        this->regs->getPC(),
+                                        rd, imm);
             }
 
             return true;
@@ -743,9 +356,9 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SWSP: x{:d}(0x{:x}) -> x{:d} + {} (@0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs2, data, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SWSP: x{:d}(0x{:x}) -> x{:d} + {} (@0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs2, data, rs1, imm, mem_addr);
 
             return true;
         }
@@ -767,9 +380,9 @@ namespace riscv_tlm {
                 new_pc = static_cast<unsigned_T>(this->regs->getPC());
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.BEQZ: x{:d}(0x{:x}) == 0? -> PC (0xx{:d})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, val1, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.BEQZ: x{:d}(0x{:x}) == 0? -> PC (0xx{:d})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, val1, new_pc);
 
             return true;
         }
@@ -791,9 +404,9 @@ namespace riscv_tlm {
                 new_pc = static_cast<unsigned_T>(this->regs->getPC());
             }
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.BNEZ: x{:d}(0x{:x}) != 0? -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc,
-                                rs1, val1, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.BNEZ: x{:d}(0x{:x}) != 0? -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc,
+                                    rs1, val1, new_pc);
 
             return true;
         }
@@ -810,9 +423,9 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.LI: x{:d} ({:d}) + {:d} -> x{:d}(0x{:x}) ",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs1, this->regs->getValue(rs1), imm, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.LI: x{:d} ({:d}) + {:d} -> x{:d}(0x{:x}) ",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs1, this->regs->getValue(rs1), imm, rd, calc);
 
             return true;
         }
@@ -824,16 +437,16 @@ namespace riscv_tlm {
 
             rd = get_rs1p();
             rs1 = get_rs1p();
-            rs2 = get_imm_ADDI();
+            rs2 = get_shamt();
 
             shift = rs2;
 
             calc = static_cast<unsigned_T>(this->regs->getValue(rs1)) >> shift;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SRLI: x{:d} >> {} -> x{:d}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SRLI: x{:d} >> {} -> x{:d}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd);
 
             return true;
         }
@@ -845,17 +458,17 @@ namespace riscv_tlm {
 
             rd = get_rs1p();
             rs1 = get_rs1p();
-            rs2 = get_imm_ADDI();
+            rs2 = get_shamt();
 
             shift = rs2;
 
             calc = static_cast<signed_T>(this->regs->getValue(rs1)) >> shift;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SRAI: x{:d} >> {} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SRAI: x{:d} >> {} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -867,15 +480,15 @@ namespace riscv_tlm {
 
             rd = get_rs1();
             rs1 = get_rs1();
-            shift = get_imm_ADDI();
+            shift = get_shamt();
 
             calc = this->regs->getValue(rs1) << shift;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SLLI: x{:d} << {} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, shift, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SLLI: x{:d} << {} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, shift, rd, calc);
 
             return true;
         }
@@ -892,10 +505,10 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) & imm;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. ANDI: x{:d} C.AND 0x{:x} -> x{:d}",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. ANDI: x{:d} C.AND 0x{:x} -> x{:d}",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, rd);
 
             return true;
         }
@@ -911,10 +524,10 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) - this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SUB: x{:d} - x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SUB: x{:d} - x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -930,10 +543,10 @@ namespace riscv_tlm {
             calc =  static_cast<std::int32_t>((this->regs->getValue(rs1) - this->regs->getValue(rs2)) & 0xFFFFFFFF);
             this->regs->setValue(rd, static_cast<std::int32_t>(calc));
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SUBW: x{:d} - x{:d} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SUBW: x{:d} - x{:d} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -949,10 +562,10 @@ namespace riscv_tlm {
             calc = static_cast<std::int32_t>((this->regs->getValue(rs1) + this->regs->getValue(rs2)) & 0xFFFFFFFF);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.ADDW: x{:d} + x{} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.ADDW: x{:d} + x{} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, calc);
 
             return true;
         }
@@ -970,13 +583,12 @@ namespace riscv_tlm {
             mem_addr = imm + this->regs->getValue(rs1);
             data = this->regs->getValue(rs2);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SDSP: 0x{:x} -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs2, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SDSP: 0x{:x} -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs2, rs1, imm, mem_addr);
 
-            this->mem_intf->writeDataMem(mem_addr, data & 0xFFFFFFFF, 4);
-            this->mem_intf->writeDataMem(mem_addr + 4, data >> 32, 4);
+            this->mem_intf->writeDataMem(mem_addr, data, 8);
             this->perf->dataMemoryWrite();
 
             return true;
@@ -993,9 +605,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) ^ this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.XOR: x{:d} XOR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.XOR: x{:d} XOR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd);
 
             return true;
         }
@@ -1011,9 +623,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) | this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.OR: x{:d} OR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.OR: x{:d} OR x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd);
 
             return true;
         }
@@ -1029,9 +641,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) & this->regs->getValue(rs2);
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.AND: x{:d} AND x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.AND: x{:d} AND x{:d} -> x{:d}", sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd);
 
             return true;
         }
@@ -1048,9 +660,9 @@ namespace riscv_tlm {
             calc = this->regs->getValue(rs1) + imm;
             this->regs->setValue(rd, calc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.ADDI: x{:d} + {} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(), rs1, imm, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.ADDI: x{:d} + {} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(), rs1, imm, rd, calc);
 
             return true;
         }
@@ -1070,9 +682,9 @@ namespace riscv_tlm {
             calc = static_cast<std::int32_t>(aux);
 
             this->regs->setValue(rd, calc);
-            this->logger->debug("{} ns. PC: 0x{:x}. C.ADDIW: x{:d} + {} -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(), rs1, imm, rd, calc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.ADDIW: x{:d} + {} -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(), rs1, imm, rd, calc);
 
             return true;
         }
@@ -1091,10 +703,10 @@ namespace riscv_tlm {
             this->regs->setValue(rd, old_pc + 2);
             this->regs->setPC(new_pc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.JALR: x{:d} <- 0x{:x} PC <- 0xx{:x}",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rd, old_pc + 4, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.JALR: x{:d} <- 0x{:x} PC <- 0xx{:x}",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rd, old_pc + 4, new_pc);
 
             return true;
         }
@@ -1115,9 +727,9 @@ namespace riscv_tlm {
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.LW: x{:d}(0x{:x}) + {:d} (@0x{:x}) -> {:d} (0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs1, this->regs->getValue(rs1), imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.LW: x{:d}(0x{:x}) + {:d} (@0x{:x}) -> {:d} (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs1, this->regs->getValue(rs1), imm, mem_addr, rd, data);
 
             return true;
         }
@@ -1133,17 +745,15 @@ namespace riscv_tlm {
             imm = get_imm_CL();
 
             mem_addr = imm + this->regs->getValue(rs1);
-            data = static_cast<std::uint32_t>(this->mem_intf->readDataMem(mem_addr, 4));
-            std::uint64_t aux = static_cast<std::uint32_t>(this->mem_intf->readDataMem(mem_addr + 4, 4));
-            data |= aux << 32;
+            data = this->mem_intf->readDataMem(mem_addr, 8);
 
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.LD: 0x{:x} + x{:d} (0x{:x}) -> x{:d}(0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, imm, mem_addr, rd, data);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.LD: 0x{:x} + x{:d} (0x{:x}) -> x{:d}(0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, imm, mem_addr, rd, data);
 
             return true;
         }
@@ -1161,13 +771,12 @@ namespace riscv_tlm {
             mem_addr = imm + this->regs->getValue(rs1);
             data = this->regs->getValue(rs2);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SD: 0x{:x} -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs2, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SD: 0x{:x} -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs2, rs1, imm, mem_addr);
 
-            this->mem_intf->writeDataMem(mem_addr, data & 0xFFFFFFFF, 4);
-            this->mem_intf->writeDataMem(mem_addr + 4, data >> 32, 4);
+            this->mem_intf->writeDataMem(mem_addr, data, 8);
             this->perf->dataMemoryWrite();
 
             return true;
@@ -1189,9 +798,9 @@ namespace riscv_tlm {
             this->mem_intf->writeDataMem(mem_addr, data, 4);
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SW: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs2, data, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SW: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs2, data, rs1, imm, mem_addr);
 
             return true;
         }
@@ -1201,7 +810,6 @@ namespace riscv_tlm {
             unsigned int rs1, rs2;
             std::int32_t imm;
             std::uint64_t data;
-            std::uint32_t aux;
 
             rs1 = get_rs1p();
             rs2 = get_rs2p();
@@ -1210,17 +818,13 @@ namespace riscv_tlm {
             mem_addr = imm + this->regs->getValue(rs1);
             data = this->regs->getValue(rs2);
 
-            aux = data >> 32;
-            this->mem_intf->writeDataMem(mem_addr, aux, 4);
-
-            aux = data & 0x00000000FFFFFFFF;
-            this->mem_intf->writeDataMem(mem_addr+4, aux, 4);
+            this->mem_intf->writeDataMem(mem_addr, data, 8);
 
             this->perf->dataMemoryWrite();
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.SD: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                rs2, data, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.SD: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    rs2, data, rs1, imm, mem_addr);
             return true;
         }
 
@@ -1230,7 +834,6 @@ namespace riscv_tlm {
             unsigned int rd, rs1;
             unsigned_T imm;
             std::uint64_t data;
-            std::uint64_t aux;
 
             rd = this->get_rd();
             rs1 = 2;
@@ -1242,16 +845,14 @@ namespace riscv_tlm {
             }
 
             mem_addr = imm + this->regs->getValue(rs1);
-            data  = static_cast<std::uint32_t>(this->mem_intf->readDataMem(mem_addr, 4));
-            aux = static_cast<std::uint32_t>(this->mem_intf->readDataMem(mem_addr + 4, 4));
-            data |= aux << 32;
+            data = this->mem_intf->readDataMem(mem_addr, 8);
 
             this->perf->dataMemoryRead();
             this->regs->setValue(rd, data);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.LDSP: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
-                                sc_core::sc_time_stamp().value(), this->regs->getPC(),
-                                2, data, rs1, imm, mem_addr);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.LDSP: x{:d}(0x{:x}) -> x{:d} + 0x{:x}(@0x{:x})",
+                                    sc_core::sc_time_stamp().value(), this->regs->getPC(),
+                                    2, data, rs1, imm, mem_addr);
             return true;
         }
 
@@ -1271,16 +872,16 @@ namespace riscv_tlm {
             old_pc = old_pc + 2;
             this->regs->setValue(rd, old_pc);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.JAL: x{:d} <- 0x{:x}. PC + 0x{:x} -> PC (0x{:x})",
-                                sc_core::sc_time_stamp().value(), old_pc - 2,
-                                rd, old_pc, mem_addr, new_pc);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.JAL: x{:d} <- 0x{:x}. PC + 0x{:x} -> PC (0x{:x})",
+                                    sc_core::sc_time_stamp().value(), old_pc - 2,
+                                    rd, old_pc, mem_addr, new_pc);
 
             return true;
         }
 
         bool Exec_C_EBREAK() {
 
-            this->logger->debug("{} ns. PC: 0x{:x}. C.EBREAK", sc_core::sc_time_stamp().value(), this->regs->getPC());
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. C.EBREAK", sc_core::sc_time_stamp().value(), this->regs->getPC());
             std::cout << std::endl << "C.EBRAK  Instruction called, dumping information"
                       << std::endl;
             this->regs->dump();
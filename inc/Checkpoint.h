@@ -0,0 +1,81 @@
+/*!
+ \file Checkpoint.h
+ \brief Save and restore full system state
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_CHECKPOINT_H_
+#define INC_CHECKPOINT_H_
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace riscv_tlm {
+
+    class CPU;
+    class Memory;
+
+    namespace peripherals {
+        class Timer;
+    }
+
+    /**
+     * @brief System checkpoint
+     *
+     * File layout: header, CPU state (registers, CSRs, IRQ flags), Timer
+     * state, memory description and the list of saved pages, followed by the
+     * page contents aligned to the host page size. Only pages holding some
+     * non-zero byte are saved, and on restore they are mapped from the file,
+     * so they are read from disk the first time the guest touches them.
+     */
+    class Checkpoint {
+    public:
+        enum {
+            VERSION = 4
+        };
+
+        /**
+         * @brief Save system state, must be called between instructions
+         * @param filename checkpoint file
+         * @param cpu CPU
+         * @param memory main memory
+         * @param timer timer peripheral
+         * @return true on success
+         */
+        static bool save(const std::string &filename, CPU *cpu, Memory *memory, peripherals::Timer *timer);
+
+        /**
+         * @brief Restore system state, must be called before simulation starts
+         * @param filename checkpoint file
+         * @param cpu CPU
+         * @param memory main memory
+         * @param timer timer peripheral
+         * @return true on success
+         */
+        static bool restore(const std::string &filename, CPU *cpu, Memory *memory, peripherals::Timer *timer);
+
+        /**
+         * @brief Write a value in host (little endian) format
+         */
+        template<typename V>
+        static void put(std::ostream &out, V value) {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(V));
+        }
+
+        /**
+         * @brief Read a value written by put()
+         */
+        template<typename V>
+        static V get(std::istream &in) {
+            V value{};
+            in.read(reinterpret_cast<char *>(&value), sizeof(V));
+            return value;
+        }
+    };
+}
+
+#endif /* INC_CHECKPOINT_H_ */
@@ -0,0 +1,127 @@
+/*!
+ \file DecodeCache.h
+ \brief Predecoded instruction cache
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_DECODECACHE_H_
+#define INC_DECODECACHE_H_
+
+#include <array>
+#include <cstdint>
+#include <unordered_set>
+
+#include "Instruction.h"
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Instruction already fetched and decoded, ready to be executed
+     */
+    struct decoded_instr {
+        std::uint64_t pc;           /**< address of the instruction */
+        std::uint32_t instr;        /**< instruction word as fetched */
+        extension_t extension;      /**< extension that executes it */
+        std::uint32_t code;         /**< opCodes, op_C_Codes, op_M_Codes or op_A_Codes value */
+        std::uint8_t fusion;        /**< fusion_t of the pair this instruction heads, if any */
+        bool valid;
+    };
+
+    /**
+     * @brief Direct-mapped cache of decoded instructions indexed by PC
+     *
+     * A PC found in the cache skips both the fetch and the decode. Stores
+     * done by the CPU must call invalidate() so self-modifying code is
+     * handled properly.
+     */
+    class DecodeCache {
+    public:
+        /* Number of entries, must be a power of 2 */
+        enum {
+            ENTRIES = 8192
+        };
+
+        /* Code is tracked in lines of 2^LINE_SHIFT bytes */
+        static constexpr unsigned int LINE_SHIFT = 6;
+
+        DecodeCache();
+
+        /**
+         * @brief Look for a decoded instruction
+         * @param pc address of the instruction
+         * @return decoded instruction or nullptr if it is not in the cache
+         */
+        inline decoded_instr *lookup(std::uint64_t pc) {
+            decoded_instr &entry = cache[index(pc)];
+
+            if (entry.valid && (entry.pc == pc)) {
+                return &entry;
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Stores a new decoded instruction, replacing the old one (if any)
+         * @param pc address of the instruction
+         * @param instr instruction word
+         * @param extension extension that decoded the instruction
+         * @param code opcode returned by the extension decoder
+         * @return the new entry
+         */
+        decoded_instr *insert(std::uint64_t pc, std::uint32_t instr,
+                              extension_t extension, std::uint32_t code);
+
+        /**
+         * @brief Drop any instruction overlapping a written memory range
+         * @param addr first address written
+         * @param len number of bytes written
+         */
+        inline void invalidate(std::uint64_t addr, unsigned int len) {
+            /* Fast path: data accesses are usually far from code */
+            if ((addr >= code_end) || (addr + len <= code_start)) {
+                return;
+            }
+            invalidate_range(addr, len);
+        }
+
+        /**
+         * @brief Drop all entries
+         */
+        void flush();
+
+        /**
+         * @brief Number of writes to code so far, lets other caches
+         * built on top of this one know when they are stale
+         */
+        std::uint64_t getGeneration() const {
+            return generation;
+        }
+
+    private:
+        static inline std::size_t index(std::uint64_t pc) {
+            return (pc >> 1) & (ENTRIES - 1);
+        }
+
+        void invalidate_range(std::uint64_t addr, unsigned int len);
+
+        std::array<decoded_instr, ENTRIES> cache{};
+
+        /**
+         * @brief Address range covered by cached instructions
+         */
+        std::uint64_t code_start;
+        std::uint64_t code_end;
+
+        /**
+         * @brief Lines holding any instruction decoded since the last flush.
+         * Entries replaced in the cache may still be copied in translated
+         * blocks, so lines are kept until flush()
+         */
+        std::unordered_set<std::uint64_t> code_lines;
+        std::uint64_t generation = 0;
+    };
+}
+
+#endif /* INC_DECODECACHE_H_ */
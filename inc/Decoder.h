@@ -0,0 +1,128 @@
+/*!
+ \file Decoder.h
+ \brief Table driven decoder of all supported extensions
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_DECODER_H_
+#define INC_DECODER_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Instruction.h"
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Decodes an instruction word to its extension and opcode in a
+     * fixed number of table lookups
+     *
+     * The first lookup uses quadrant and funct3 for compressed instructions
+     * and opcode and funct3 for the rest, which is enough for most of them.
+     * Entries that need more bits (funct7 for OP and OP-32, funct5 for AMOs,
+     * funct12 for SYSTEM, the C.SUB group...) point to a child table indexed
+     * by the next field, three levels deep at most.
+     *
+     * Tables are generated in the constructor for the given XLEN, the only
+     * difference between RV32 and RV64 being a few compressed instructions,
+     * and extension set. Instructions of extensions left out decode as
+     * UNKNOWN_EXTENSION.
+     */
+    class Decoder {
+    public:
+        /**
+         * @brief Bit of an extension in the extension set
+         */
+        static constexpr std::uint32_t extension_bit(extension_t extension) {
+            return 1U << extension;
+        }
+
+        static constexpr std::uint32_t ALL_EXTENSIONS = (1U << BASE_EXTENSION) | (1U << M_EXTENSION) |
+                                                        (1U << A_EXTENSION) | (1U << C_EXTENSION);
+
+        /**
+         * @brief Build the decode tables
+         * @param xlen 32 or 64
+         * @param extensions extension_bit() of the decoded extensions, base
+         * ISA is always decoded
+         */
+        explicit Decoder(unsigned int xlen, std::uint32_t extensions = ALL_EXTENSIONS);
+
+        /**
+         * @brief Decode an instruction
+         * @param instr instruction word, upper half is ignored for compressed ones
+         * @param extension extension that executes it, UNKNOWN_EXTENSION if illegal
+         * @param code opCodes, op_C_Codes, op_M_Codes or op_A_Codes value
+         */
+        inline void decode(std::uint32_t instr, extension_t *extension, std::uint32_t *code) const {
+            const entry *e = &root[root_index(instr)];
+
+            while (e->bits != 0) {
+                e = &nodes[e->value + ((instr >> e->shift) & ((1U << e->bits) - 1))];
+            }
+
+            *extension = static_cast<extension_t>(e->extension);
+            *code = e->value;
+        }
+
+    private:
+        /**
+         * @brief Leaf (bits == 0) with the decoded instruction, or a link to
+         * 2^bits child entries indexed by instr[shift + bits - 1 : shift]
+         */
+        struct entry {
+            std::uint8_t extension;
+            std::uint8_t shift;
+            std::uint8_t bits;
+            std::uint32_t value;        /**< code of a leaf, first child of a link */
+        };
+
+        enum {
+            C_ENTRIES = 4 * 8,          /**< quadrant, funct3 */
+            ROOT_ENTRIES = C_ENTRIES + 32 * 8,  /**< + opcode[6:2], funct3 */
+        };
+
+        static inline std::size_t root_index(std::uint32_t instr) {
+            if ((instr & 0b11) != 0b11) {
+                return ((instr & 0b11) << 3) | ((instr >> 13) & 0b111);
+            }
+            return C_ENTRIES + ((((instr >> 2) & 0x1F) << 3) | ((instr >> 12) & 0b111));
+        }
+
+        static inline std::size_t full_index(std::uint32_t opcode, std::uint32_t funct3) {
+            return C_ENTRIES + (((opcode >> 2) << 3) | funct3);
+        }
+
+        static inline std::size_t c_index(std::uint32_t quadrant, std::uint32_t funct3) {
+            return (quadrant << 3) | funct3;
+        }
+
+        /**
+         * @brief Make e a leaf
+         */
+        static void set(entry &e, extension_t extension, std::uint32_t code);
+
+        /**
+         * @brief Make the entry at the given position a link to a new child
+         * table, children start as copies of the old entry
+         * @param in_root true for a root entry, false for a node entry
+         * @param index position of the entry
+         * @return index in nodes of the first child
+         */
+        std::uint32_t split(bool in_root, std::size_t index, unsigned int shift, unsigned int bits);
+
+        void build_base();
+        void build_c(unsigned int xlen);
+        void build_m();
+        void build_a();
+
+        std::array<entry, ROOT_ENTRIES> root{};
+        std::vector<entry> nodes;
+    };
+}
+
+#endif /* INC_DECODER_H_ */
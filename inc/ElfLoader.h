@@ -0,0 +1,138 @@
+/*!
+ \file ElfLoader.h
+ \brief ELF file loader and symbol table
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_ELFLOADER_H_
+#define INC_ELFLOADER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Symbol read from an ELF file
+     */
+    struct elf_symbol {
+        std::string name;
+        std::uint64_t address;
+        std::uint64_t size;
+    };
+
+    /**
+     * @brief Program symbols sorted by address, to name addresses in
+     * profiles and debugger sessions
+     */
+    class SymbolTable {
+    public:
+        /**
+         * @brief Adds a symbol, sort() must be called before any lookup
+         */
+        void add(const std::string &name, std::uint64_t address, std::uint64_t size);
+
+        /**
+         * @brief Sorts symbols by address
+         */
+        void sort();
+
+        /**
+         * @brief Look for the symbol an address belongs to
+         * @param address address to look for
+         * @return symbol or nullptr if no symbol contains the address
+         */
+        const elf_symbol *find(std::uint64_t address) const;
+
+        /**
+         * @brief Look for a symbol by name
+         * @param name symbol name
+         * @param address symbol address, if found
+         * @return true if symbol exists
+         */
+        bool getAddress(const std::string &name, std::uint64_t *address) const;
+
+        std::size_t size() const {
+            return symbols.size();
+        }
+
+    private:
+        std::vector<elf_symbol> symbols;
+    };
+
+    /**
+     * @brief Segment to load in memory
+     */
+    struct elf_segment {
+        std::uint64_t address;      /**< physical address to load to */
+        const std::uint8_t *data;   /**< segment contents in the file */
+        std::uint64_t file_size;    /**< bytes to copy from file */
+        std::uint64_t mem_size;     /**< bytes in memory, the rest is zeroed */
+    };
+
+    /**
+     * @brief ELF32/ELF64 little endian RISC-V loader
+     *
+     * The file is mapped in memory, segments point directly to the mapping
+     * so they are only valid while the loader exists.
+     */
+    class ElfLoader {
+    public:
+        /**
+         * @brief Constructor, maps and parses the file
+         * @param filename ELF file name
+         */
+        explicit ElfLoader(const std::string &filename);
+
+        ~ElfLoader();
+
+        ElfLoader(const ElfLoader &other) = delete;
+        ElfLoader &operator=(const ElfLoader &other) = delete;
+
+        /**
+         * @brief Checks the magic number of a file
+         * @param filename file name
+         * @return true if file is an ELF file
+         */
+        static bool isElf(const std::string &filename);
+
+        /**
+         * @brief File was opened and parsed without errors
+         */
+        bool isValid() const {
+            return valid;
+        }
+
+        std::uint64_t getEntryPoint() const {
+            return entry_point;
+        }
+
+        const std::vector<elf_segment> &getSegments() const {
+            return segments;
+        }
+
+        const SymbolTable &getSymbols() const {
+            return symbols;
+        }
+
+    private:
+        /**
+         * @brief Parse headers for one of the ELF classes
+         * @return true if file is correct
+         */
+        template<typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+        bool parse();
+
+        const std::uint8_t *image;
+        std::size_t image_size;
+        bool valid;
+        std::uint64_t entry_point;
+        std::vector<elf_segment> segments;
+        SymbolTable symbols;
+    };
+}
+
+#endif /* INC_ELFLOADER_H_ */
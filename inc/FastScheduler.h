@@ -0,0 +1,105 @@
+/*!
+ \file FastScheduler.h
+ \brief Event queue for the standalone (no SystemC kernel) mode
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_FASTSCHEDULER_H_
+#define INC_FASTSCHEDULER_H_
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Time keeping and timed events for the fast mode
+     *
+     * In fast mode the Simulator drives the CPU from a host loop and the
+     * SystemC scheduler never advances time. Time is the number of executed
+     * instructions times the instruction time, and peripherals post their
+     * timed events in a min-heap checked after every step.
+     *
+     * Singleton class, time is in ns as sc_time values (resolution is 1 ns).
+     */
+    class FastScheduler {
+    public:
+        using callback_t = std::function<void()>;
+
+        /**
+         * @brief Get an instance of the class
+         * @return pointer to FastScheduler class
+         */
+        static FastScheduler *getInstance();
+
+        /**
+         * @brief Current simulation time in any mode
+         * @return FastScheduler time in fast mode, SystemC time otherwise
+         */
+        static std::uint64_t time_stamp();
+
+        void enable() {
+            enabled = true;
+        }
+
+        bool isEnabled() const {
+            return enabled;
+        }
+
+        std::uint64_t now() const {
+            return current_time;
+        }
+
+        /**
+         * @brief Post an event
+         * @param time absolute time of the event
+         * @param callback function to call at that time
+         */
+        void schedule(std::uint64_t time, callback_t callback);
+
+        /**
+         * @brief Advance time and run the events that are due
+         * @param delta time elapsed since last call
+         */
+        inline void advance(std::uint64_t delta) {
+            current_time += delta;
+            if (!events.empty() && (events.top().time <= current_time)) {
+                run_events();
+            }
+        }
+
+        /**
+         * @brief Jump to the next event and run it (with any other due at
+         * that time)
+         * @return false if there are no events left
+         */
+        bool run_next();
+
+    private:
+        struct event {
+            std::uint64_t time;
+            std::uint64_t sequence;     /**< keeps posting order for events at the same time */
+            callback_t callback;
+
+            bool operator>(const event &other) const {
+                return (time > other.time) || ((time == other.time) && (sequence > other.sequence));
+            }
+        };
+
+        static FastScheduler *instance;
+        FastScheduler();
+
+        void run_events();
+
+        bool enabled;
+        std::uint64_t current_time;
+        std::uint64_t sequence;
+        std::priority_queue<event, std::vector<event>, std::greater<event>> events;
+    };
+}
+
+#endif /* INC_FASTSCHEDULER_H_ */
@@ -0,0 +1,169 @@
+/*!
+ \file Fusion.h
+ \brief Macro-op fusion of common instruction pairs
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_FUSION_H_
+#define INC_FUSION_H_
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "BASE_ISA.h"
+#include "C_extension.h"
+#include "DecodeCache.h"
+#include "InstrFields.h"
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Kind of pair an instruction heads, stored in decoded_instr::fusion
+     */
+    typedef enum : std::uint8_t {
+        FUSE_NONE = 0,
+        FUSE_LUI_ADDI,      /**< (c.)lui rd + addi(w) rd, rd: 32-bit constant */
+        FUSE_AUIPC_JALR,    /**< auipc rd + jalr (rd): far call or jump */
+        FUSE_AUIPC_LOAD,    /**< auipc rd + lw/lwu/ld (rd): PC-relative load */
+        FUSE_SLLI_SRLI,     /**< (c.)slli rd + srli rd, rd: zero extension */
+        FUSE_CMP_BRANCH,    /**< slt(i)(u) rd + beq/bne on rd and x0 */
+    } fusion_t;
+
+    /**
+     * @brief Finds instruction pairs the interpreter executes in one step
+     *
+     * The second instruction of a pair reads the register the first one
+     * writes. Either of them can be compressed. CPUCore::exec_fused runs the
+     * pair as one operation; registers, PC, counters and retired instructions
+     * end up as after two steps.
+     */
+    class Fusion {
+    public:
+        /**
+         * @brief Size of an instruction
+         */
+        static unsigned int length(const decoded_instr &entry) {
+            return (entry.extension == C_EXTENSION) ? 2 : 4;
+        }
+
+        /**
+         * @brief Checks if two consecutive instructions form a pair
+         * @param first instruction at PC
+         * @param second instruction right after first
+         * @return kind of pair, FUSE_NONE if they are not fused
+         */
+        static fusion_t pair(const decoded_instr &first, const decoded_instr &second) {
+            if (first.extension == C_EXTENSION) {
+                std::uint32_t rd = fields::c_rs1(first.instr);
+                if (rd == 0) {
+                    return FUSE_NONE;
+                }
+
+                switch (static_cast<op_C_Codes>(first.code)) {
+                    case OP_C_ADDI16SP:
+                        /* C.LUI shares the decoder entry, rd is not sp */
+                        if (rd == 2) {
+                            return FUSE_NONE;
+                        }
+                        return writes_own_source(second, rd) ? FUSE_LUI_ADDI : FUSE_NONE;
+                    case OP_C_SLLI:
+                        return shifts_back(second, rd) ? FUSE_SLLI_SRLI : FUSE_NONE;
+                    default:
+                        return FUSE_NONE;
+                }
+            }
+
+            if (first.extension != BASE_EXTENSION) {
+                return FUSE_NONE;
+            }
+
+            std::uint32_t rd = fields::rd(first.instr);
+            if (rd == 0) {
+                return FUSE_NONE;
+            }
+
+            switch (static_cast<opCodes>(first.code)) {
+                case OP_LUI:
+                    return writes_own_source(second, rd) ? FUSE_LUI_ADDI : FUSE_NONE;
+                case OP_AUIPC:
+                    if (is_base(second, {OP_JALR}) && (fields::rs1(second.instr) == rd)) {
+                        return FUSE_AUIPC_JALR;
+                    }
+                    if (is_base(second, {OP_LW, OP_LWU, OP_LD}) && (fields::rs1(second.instr) == rd)) {
+                        return FUSE_AUIPC_LOAD;
+                    }
+                    return FUSE_NONE;
+                case OP_SLLI:
+                    return shifts_back(second, rd) ? FUSE_SLLI_SRLI : FUSE_NONE;
+                case OP_SLT:
+                case OP_SLTU:
+                case OP_SLTI:
+                case OP_SLTIU:
+                    return tests_zero(second, rd) ? FUSE_CMP_BRANCH : FUSE_NONE;
+                default:
+                    return FUSE_NONE;
+            }
+        }
+
+    private:
+        static bool is_base(const decoded_instr &entry, std::initializer_list<opCodes> codes) {
+            if (entry.extension != BASE_EXTENSION) {
+                return false;
+            }
+            for (auto code : codes) {
+                if (entry.code == code) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool is_c(const decoded_instr &entry, std::initializer_list<op_C_Codes> codes) {
+            if (entry.extension != C_EXTENSION) {
+                return false;
+            }
+            for (auto code : codes) {
+                if (entry.code == code) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief addi(w) rd, rd, imm or its compressed form
+         */
+        static bool writes_own_source(const decoded_instr &entry, std::uint32_t rd) {
+            if (is_base(entry, {OP_ADDI, OP_ADDIW})) {
+                return (fields::rd(entry.instr) == rd) && (fields::rs1(entry.instr) == rd);
+            }
+            return is_c(entry, {OP_C_ADDI, OP_C_ADDIW}) && (fields::c_rs1(entry.instr) == rd);
+        }
+
+        /**
+         * @brief srli rd, rd, shamt or its compressed form
+         */
+        static bool shifts_back(const decoded_instr &entry, std::uint32_t rd) {
+            if (is_base(entry, {OP_SRLI})) {
+                return (fields::rd(entry.instr) == rd) && (fields::rs1(entry.instr) == rd);
+            }
+            return is_c(entry, {OP_C_SRLI}) && (fields::c_rs1p(entry.instr) == rd);
+        }
+
+        /**
+         * @brief beq/bne comparing rd with x0, or c.beqz/c.bnez on rd
+         */
+        static bool tests_zero(const decoded_instr &entry, std::uint32_t rd) {
+            if (is_base(entry, {OP_BEQ, OP_BNE})) {
+                std::uint32_t rs1 = fields::rs1(entry.instr);
+                std::uint32_t rs2 = fields::rs2(entry.instr);
+                return ((rs1 == rd) && (rs2 == 0)) || ((rs1 == 0) && (rs2 == rd));
+            }
+            return is_c(entry, {OP_C_BEQZ, OP_C_BNEZ}) && (fields::c_rs1p(entry.instr) == rd);
+        }
+    };
+}
+
+#endif /* INC_FUSION_H_ */
@@ -0,0 +1,238 @@
+/*!
+ \file InstrFields.h
+ \brief Register and immediate fields of RV32, RV64 and RVC instruction formats
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_INSTRFIELDS_H_
+#define INC_INSTRFIELDS_H_
+
+#include <cstdint>
+
+namespace riscv_tlm::fields {
+
+    /**
+     * All functions take the instruction word as fetched and are constexpr,
+     * so they compile to a few shifts and masks inlined in the callers.
+     * Signed immediates are returned sign-extended to 32 bits, callers
+     * widen them to XLEN. Known encodings are checked with static_assert
+     * in InstrFields.cpp.
+     */
+
+    /**
+     * @brief instr[hi:lo], right aligned
+     */
+    constexpr std::uint32_t bits(std::uint32_t instr, unsigned int hi, unsigned int lo) {
+        return (instr >> lo) & ((hi - lo == 31) ? 0xFFFFFFFFU : ((1U << (hi - lo + 1)) - 1));
+    }
+
+    /**
+     * @brief instr[hi:lo] moved to bit position to
+     */
+    constexpr std::uint32_t move(std::uint32_t instr, unsigned int hi, unsigned int lo, unsigned int to) {
+        return bits(instr, hi, lo) << to;
+    }
+
+    /**
+     * @brief Sign extend the lower width bits of value
+     */
+    constexpr std::int32_t sign_extend(std::uint32_t value, unsigned int width) {
+        const std::uint32_t sign = 1U << (width - 1);
+        return static_cast<std::int32_t>(((value & ((sign << 1) - 1)) ^ sign) - sign);
+    }
+
+    /* 32-bit formats */
+
+    constexpr std::uint32_t opcode(std::uint32_t instr) {
+        return bits(instr, 6, 0);
+    }
+
+    constexpr std::uint32_t rd(std::uint32_t instr) {
+        return bits(instr, 11, 7);
+    }
+
+    constexpr std::uint32_t rs1(std::uint32_t instr) {
+        return bits(instr, 19, 15);
+    }
+
+    constexpr std::uint32_t rs2(std::uint32_t instr) {
+        return bits(instr, 24, 20);
+    }
+
+    constexpr std::uint32_t funct3(std::uint32_t instr) {
+        return bits(instr, 14, 12);
+    }
+
+    constexpr std::uint32_t funct7(std::uint32_t instr) {
+        return bits(instr, 31, 25);
+    }
+
+    /**
+     * @brief AMO operation, without aq and rl
+     */
+    constexpr std::uint32_t funct5(std::uint32_t instr) {
+        return bits(instr, 31, 27);
+    }
+
+    constexpr std::uint32_t csr(std::uint32_t instr) {
+        return bits(instr, 31, 20);
+    }
+
+    /**
+     * @brief Shift amount of SLLI, SRLI and SRAI, 6 bits for RV64
+     */
+    constexpr std::uint32_t shamt(std::uint32_t instr) {
+        return bits(instr, 25, 20);
+    }
+
+    constexpr std::int32_t imm_I(std::uint32_t instr) {
+        return sign_extend(bits(instr, 31, 20), 12);
+    }
+
+    constexpr std::int32_t imm_S(std::uint32_t instr) {
+        return sign_extend(move(instr, 31, 25, 5) | bits(instr, 11, 7), 12);
+    }
+
+    constexpr std::int32_t imm_B(std::uint32_t instr) {
+        return sign_extend(move(instr, 31, 31, 12) | move(instr, 7, 7, 11) |
+                           move(instr, 30, 25, 5) | move(instr, 11, 8, 1), 13);
+    }
+
+    /**
+     * @brief U-type immediate, not shifted (instr[31:12])
+     */
+    constexpr std::uint32_t imm_U(std::uint32_t instr) {
+        return bits(instr, 31, 12);
+    }
+
+    constexpr std::int32_t imm_J(std::uint32_t instr) {
+        return sign_extend(move(instr, 31, 31, 20) | move(instr, 19, 12, 12) |
+                           move(instr, 20, 20, 11) | move(instr, 30, 21, 1), 21);
+    }
+
+    /* Compressed formats */
+
+    constexpr std::uint32_t c_op(std::uint32_t instr) {
+        return bits(instr, 1, 0);
+    }
+
+    constexpr std::uint32_t c_funct3(std::uint32_t instr) {
+        return bits(instr, 15, 13);
+    }
+
+    /**
+     * @brief rd/rs1 of CR and CI formats
+     */
+    constexpr std::uint32_t c_rs1(std::uint32_t instr) {
+        return bits(instr, 11, 7);
+    }
+
+    constexpr std::uint32_t c_rs2(std::uint32_t instr) {
+        return bits(instr, 6, 2);
+    }
+
+    /**
+     * @brief rd' of CIW and CL formats (x8 to x15)
+     */
+    constexpr std::uint32_t c_rdp(std::uint32_t instr) {
+        return bits(instr, 4, 2) + 8;
+    }
+
+    /**
+     * @brief rs1' (rd' for CA and CB) (x8 to x15)
+     */
+    constexpr std::uint32_t c_rs1p(std::uint32_t instr) {
+        return bits(instr, 9, 7) + 8;
+    }
+
+    constexpr std::uint32_t c_rs2p(std::uint32_t instr) {
+        return bits(instr, 4, 2) + 8;
+    }
+
+    /**
+     * @brief C.J and C.JAL offset
+     */
+    constexpr std::int32_t c_imm_J(std::uint32_t instr) {
+        return sign_extend(move(instr, 12, 12, 11) | move(instr, 11, 11, 4) | move(instr, 10, 9, 8) |
+                           move(instr, 8, 8, 10) | move(instr, 7, 7, 6) | move(instr, 6, 6, 7) |
+                           move(instr, 5, 3, 1) | move(instr, 2, 2, 5), 12);
+    }
+
+    /**
+     * @brief C.LW and C.SW offset
+     */
+    constexpr std::uint32_t c_imm_L(std::uint32_t instr) {
+        return move(instr, 12, 10, 3) | move(instr, 6, 6, 2) | move(instr, 5, 5, 6);
+    }
+
+    /**
+     * @brief C.LD and C.SD offset
+     */
+    constexpr std::uint32_t c_imm_CL(std::uint32_t instr) {
+        return move(instr, 12, 10, 3) | move(instr, 6, 5, 6);
+    }
+
+    constexpr std::uint32_t c_imm_LWSP(std::uint32_t instr) {
+        return move(instr, 12, 12, 5) | move(instr, 6, 4, 2) | move(instr, 3, 2, 6);
+    }
+
+    constexpr std::uint32_t c_imm_LDSP(std::uint32_t instr) {
+        return move(instr, 12, 12, 5) | move(instr, 6, 5, 3) | move(instr, 4, 2, 6);
+    }
+
+    /**
+     * @brief C.SWSP offset
+     */
+    constexpr std::uint32_t c_imm_CSS(std::uint32_t instr) {
+        return move(instr, 12, 9, 2) | move(instr, 8, 7, 6);
+    }
+
+    /**
+     * @brief C.SDSP offset
+     */
+    constexpr std::uint32_t c_imm_CSDSP(std::uint32_t instr) {
+        return move(instr, 12, 10, 3) | move(instr, 9, 7, 6);
+    }
+
+    /**
+     * @brief CI immediate of C.ADDI, C.ADDIW, C.LI, C.ANDI and shifts
+     */
+    constexpr std::int32_t c_imm_ADDI(std::uint32_t instr) {
+        return sign_extend(move(instr, 12, 12, 5) | bits(instr, 6, 2), 6);
+    }
+
+    /**
+     * @brief Shift amount of C.SLLI, C.SRLI and C.SRAI, unsigned 6 bits
+     */
+    constexpr std::uint32_t c_shamt(std::uint32_t instr) {
+        return move(instr, 12, 12, 5) | bits(instr, 6, 2);
+    }
+
+    constexpr std::uint32_t c_imm_ADDI4SPN(std::uint32_t instr) {
+        return move(instr, 12, 11, 4) | move(instr, 10, 7, 6) | move(instr, 6, 6, 2) | move(instr, 5, 5, 3);
+    }
+
+    constexpr std::int32_t c_imm_ADDI16SP(std::uint32_t instr) {
+        return sign_extend(move(instr, 12, 12, 9) | move(instr, 6, 6, 4) | move(instr, 5, 5, 6) |
+                           move(instr, 4, 3, 7) | move(instr, 2, 2, 5), 10);
+    }
+
+    /**
+     * @brief C.BEQZ and C.BNEZ offset
+     */
+    constexpr std::int32_t c_imm_CB(std::uint32_t instr) {
+        return sign_extend(move(instr, 12, 12, 8) | move(instr, 11, 10, 3) | move(instr, 6, 5, 6) |
+                           move(instr, 4, 3, 1) | move(instr, 2, 2, 5), 9);
+    }
+
+    /**
+     * @brief C.LUI immediate, already shifted
+     */
+    constexpr std::int32_t c_imm_LUI(std::uint32_t instr) {
+        return sign_extend(move(instr, 12, 12, 17) | move(instr, 6, 2, 12), 18);
+    }
+}
+
+#endif /* INC_INSTRFIELDS_H_ */
@@ -0,0 +1,205 @@
+/*!
+ \file InstrLog.h
+ \brief Instruction trace: debug log macro and binary commit trace writer
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_INSTRLOG_H_
+#define INC_INSTRLOG_H_
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+#include "TraceFormat.h"
+
+/* Instruction trace is compiled in only with -DENABLE_INSTR_LOG=ON */
+#ifdef ENABLE_INSTR_LOG
+#define INSTR_LOG_ENABLED (true)
+#else
+#define INSTR_LOG_ENABLED (false)
+#endif
+
+/**
+ * @brief Debug message of an executed instruction
+ *
+ * Arguments are only evaluated if the trace is compiled in and the logger
+ * is at debug level. Otherwise the whole call is removed by the compiler.
+ */
+#define LOG_INSTR(logger, ...)                                                  \
+    do {                                                                        \
+        if (INSTR_LOG_ENABLED && (logger)->should_log(spdlog::level::debug)) {  \
+            (logger)->debug(__VA_ARGS__);                                       \
+        }                                                                       \
+    } while (0)
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Binary commit trace of executed instructions
+     *
+     * Each record holds the PC (delta encoded), the instruction word, the
+     * register written and the memory access done, if any. See
+     * TraceFormat.h for the layout, trace_decode turns it back to text.
+     *
+     * Records are encoded in one buffer while a writer thread compresses
+     * (optionally) and writes the other one, so the CPU only waits for the
+     * disk when it is slower than the simulation.
+     */
+    class InstrLog {
+    public:
+        static constexpr bool enabled = INSTR_LOG_ENABLED;
+
+        /**
+         * @brief Create the trace file and start the writer thread
+         * @param filename trace file name
+         * @param xlen 32 or 64
+         * @param codec block compression
+         */
+        InstrLog(const std::string &filename, unsigned int xlen, trace::codec_t codec);
+
+        /**
+         * @brief Write pending records, stop the writer and close the file
+         */
+        ~InstrLog();
+
+        InstrLog(const InstrLog &other) = delete;
+        InstrLog &operator=(const InstrLog &other) = delete;
+
+        /**
+         * @brief Check if a codec was compiled in
+         * @param codec block compression
+         * @return true if codec can be used
+         */
+        static bool codecAvailable(trace::codec_t codec);
+
+        /**
+         * @brief Register written by the current instruction
+         */
+        inline void noteWrite(unsigned int reg, std::uint64_t value) {
+            rd = reg;
+            rd_value = value;
+        }
+
+        /**
+         * @brief Memory access done by the current instruction
+         */
+        inline void noteMem(std::uint64_t addr, std::uint64_t data, unsigned int size, bool write) {
+            mem_addr = addr;
+            mem_data = (size >= 8) ? data : (data & ((1ULL << (size * 8)) - 1));
+            mem_size = size;
+            mem_flags = trace::FLAG_MEM | (write ? trace::FLAG_STORE : 0);
+        }
+
+        /**
+         * @brief Add an executed instruction to the trace, with the register
+         * and memory accesses noted since the previous one
+         * @param pc address of the instruction
+         * @param instr instruction word
+         * @param length 2 or 4 bytes
+         */
+        inline void commit(std::uint64_t pc, std::uint32_t instr, unsigned int length) {
+            std::uint8_t *out = active->data() + active_size;
+            std::size_t len = 1;
+            std::uint8_t flags = mem_flags;
+
+            if (pc != next_pc) {
+                flags |= trace::FLAG_JUMP;
+                len += trace::put_varint(out + len, trace::zigzag(static_cast<std::int64_t>(pc - next_pc)));
+            }
+
+            out[len++] = static_cast<std::uint8_t>(instr);
+            out[len++] = static_cast<std::uint8_t>(instr >> 8);
+            if (length == 2) {
+                flags |= trace::FLAG_COMPRESSED;
+            } else {
+                out[len++] = static_cast<std::uint8_t>(instr >> 16);
+                out[len++] = static_cast<std::uint8_t>(instr >> 24);
+            }
+
+            if (rd != 0) {
+                flags |= trace::FLAG_RD;
+                out[len++] = static_cast<std::uint8_t>(rd);
+                len += trace::put_varint(out + len, rd_value & xlen_mask);
+                rd = 0;
+            }
+
+            if (mem_flags != 0) {
+                len += trace::put_varint(out + len, trace::zigzag(static_cast<std::int64_t>(mem_addr - prev_mem_addr)));
+                out[len++] = static_cast<std::uint8_t>(mem_size);
+                len += trace::put_varint(out + len, mem_data);
+                prev_mem_addr = mem_addr;
+                mem_flags = 0;
+            }
+
+            out[0] = flags;
+            active_size += len;
+            active_records++;
+            next_pc = pc + length;
+
+            if (active_size >= trace::BLOCK_SIZE) {
+                hand_over();
+            }
+        }
+
+        bool isOpen() const {
+            return out.is_open();
+        }
+
+    private:
+        /**
+         * @brief Give the active buffer to the writer thread and go on with
+         * the other one
+         */
+        void hand_over();
+
+        /**
+         * @brief Writer thread body
+         */
+        void writer();
+
+        /**
+         * @brief Compress (if enabled) and write one block
+         */
+        void write_block(const std::vector<std::uint8_t> &data, std::size_t size, std::uint32_t records);
+
+        std::ofstream out;
+        trace::codec_t codec;
+        std::uint64_t xlen_mask;
+
+        std::array<std::vector<std::uint8_t>, 2> buffers;
+        std::vector<std::uint8_t> *active;      /**< buffer being filled by the CPU */
+        std::size_t active_size;
+        std::uint32_t active_records;
+        std::vector<std::uint8_t> *pending;     /**< buffer being written, nullptr if none */
+        std::size_t pending_size;
+        std::uint32_t pending_records;
+        bool done;
+        std::mutex lock;
+        std::condition_variable cond;
+        std::thread writer_thread;
+
+        /* Delta encoding state, reset on every block */
+        std::uint64_t next_pc;
+        std::uint64_t prev_mem_addr;
+
+        /* Accesses of the current instruction */
+        unsigned int rd;
+        std::uint64_t rd_value;
+        std::uint8_t mem_flags;
+        unsigned int mem_size;
+        std::uint64_t mem_addr;
+        std::uint64_t mem_data;
+    };
+}
+
+#endif
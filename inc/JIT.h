@@ -0,0 +1,189 @@
+/*!
+ \file JIT.h
+ \brief Translator of hot basic blocks to native x86-64 code
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_JIT_H_
+#define INC_JIT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "BASE_ISA.h"
+#include "C_extension.h"
+#include "DecodeCache.h"
+#include "Registers.h"
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Dynamic binary translator for hot basic blocks
+     *
+     * Integer ALU instructions (RV32I/RV64I register-register and
+     * register-immediate, LUI, AUIPC and their compressed forms) are
+     * translated to x86-64 instructions working directly on the register
+     * bank. Any other instruction (loads, stores, branches, CSR, M, A...)
+     * is a call back to the interpreter handler, so MMIO, exceptions and
+     * CSR side effects behave exactly as in interpreted mode.
+     *
+     * Native code returns the number of instructions executed so the CPU
+     * keeps Performance counter and SystemC time annotation exact.
+     *
+     * Only available on x86-64 hosts, compile() returns nullptr otherwise.
+     *
+     * @tparam T register width (std::uint32_t or std::uint64_t)
+     */
+    template<typename T>
+    class JIT {
+    public:
+        using signed_T = typename std::make_signed<T>::type;
+        using unsigned_T = typename std::make_unsigned<T>::type;
+
+        /**
+         * @brief Translated block entry point
+         * @param regs register bank
+         * @param cpu CPU passed back to the helper
+         * @return number of instructions executed
+         */
+        using native_block = unsigned int (*)(T *regs, void *cpu);
+
+        /**
+         * @brief Interpreter fallback called from native code
+         * @param cpu CPU
+         * @param arg per-instruction argument given in jit_op
+         * @return true if the block can go on, false to leave the block
+         */
+        using helper_t = bool (*)(void *cpu, const void *arg);
+
+        /**
+         * @brief Instruction to translate
+         */
+        struct jit_op {
+            const decoded_instr *instr;
+            unsigned int length;
+            const void *helper_arg;
+        };
+
+        enum {
+            HOT_THRESHOLD = 32,                 /**< executions before translating a block */
+            CODE_BUFFER_SIZE = 16 * 1024 * 1024
+        };
+
+        /**
+         * @brief Constructor
+         * @param register_bank register bank the native code works on
+         * @param base_isa base extension, used to extract instruction fields
+         * @param c_ext C extension, used to extract instruction fields
+         * @param helper interpreter fallback
+         */
+        JIT(Registers<T> *register_bank, BASE_ISA<T> *base_isa, C_extension<T> *c_ext, helper_t helper);
+
+        ~JIT();
+
+        JIT(const JIT &other) = delete;
+        JIT &operator=(const JIT &other) = delete;
+
+        /**
+         * @brief Translate a basic block
+         * @param ops instructions of the block
+         * @return native block or nullptr if it cannot be translated
+         */
+        native_block compile(const std::vector<jit_op> &ops);
+
+        /**
+         * @brief Drop all translated code
+         */
+        void flush();
+
+        /**
+         * @brief Check if instruction is executed natively
+         * @param entry decoded instruction
+         * @return true if no helper call is needed
+         */
+        bool is_native(const decoded_instr &entry);
+
+        /**
+         * @brief Check if an instruction can be executed again from the same
+         * registers and CSRs, with its data accesses replayed
+         * @param entry decoded instruction
+         * @return false if it depends on or changes other state (SC
+         * reservations) or prints (ECALL, EBREAK)
+         */
+        bool is_replayable(const decoded_instr &entry);
+
+        /**
+         * @brief Check if an instruction may write CSRs: CSR instructions,
+         * xRET and anything that can raise an exception
+         * @param entry decoded instruction
+         * @return false if it never writes CSRs
+         */
+        bool may_write_csrs(const decoded_instr &entry);
+
+    private:
+        /* Operations generated for native instructions */
+        typedef enum {
+            JIT_MOVI,
+            JIT_ADD,
+            JIT_SUB,
+            JIT_XOR,
+            JIT_OR,
+            JIT_AND,
+            JIT_SLT,
+            JIT_SLTU,
+            JIT_ADDW,
+            JIT_SUBW,
+        } jit_alu_t;
+
+        struct jit_uop {
+            jit_alu_t op;
+            unsigned int rd;
+            unsigned int rs1;
+            unsigned int rs2;
+            bool use_imm;
+            std::int64_t imm;
+        };
+
+        /**
+         * @brief Map an instruction to a native operation
+         * @param entry decoded instruction
+         * @param uop native operation
+         * @return false if instruction needs the interpreter
+         */
+        bool lower(const decoded_instr &entry, jit_uop *uop);
+
+        /**
+         * @brief Make the unused end of the code buffer writable for emission,
+         * or executable once done
+         * @param offset first byte of the area, rounded down to its page
+         * @param writable true for read/write, false for read/execute
+         * @return false if protection cannot be changed
+         */
+        bool protect_tail(std::size_t offset, bool writable);
+
+        void emit8(std::uint8_t byte);
+        void emit32(std::uint32_t value);
+        void emit64(std::uint64_t value);
+        void emit_rex();
+        void emit_load(unsigned int x86_reg, unsigned int reg, bool wide);
+        void emit_store(unsigned int x86_reg, unsigned int reg, bool wide);
+        void emit_uop(const jit_uop &uop);
+        void emit_set_pc(std::uint64_t pc);
+        void emit_helper_call(const void *arg);
+        void emit_exit(unsigned int executed);
+
+        Registers<T> *regs;
+        BASE_ISA<T> *base_inst;
+        C_extension<T> *c_inst;
+        helper_t helper;
+        std::int32_t pc_offset;
+
+        std::uint8_t *code_buffer;
+        std::size_t code_used;
+        bool overflow;
+    };
+}
+
+#endif /* INC_JIT_H_ */
@@ -64,73 +64,6 @@ namespace riscv_tlm {
         using signed_T = typename std::make_signed<T>::type;
         using unsigned_T = typename std::make_unsigned<T>::type;
 
-        /**
-         * @brief Decodes opcode of instruction
-         * @return opcode of instruction
-         */
-        [[nodiscard]] op_M_Codes decode() const {
-
-            if (this->m_instr.range(6,0) == 0b110011) {
-                switch (opcode()) {
-                    case M_MUL:
-                        return OP_M_MUL;
-                        break;
-                    case M_MULH:
-                        return OP_M_MULH;
-                        break;
-                    case M_MULHSU:
-                        return OP_M_MULHSU;
-                        break;
-                    case M_MULHU:
-                        return OP_M_MULHU;
-                        break;
-                    case M_DIV:
-                        return OP_M_DIV;
-                        break;
-                    case M_DIVU:
-                        return OP_M_DIVU;
-                        break;
-                    case M_REM:
-                        return OP_M_REM;
-                        break;
-                    case M_REMU:
-                        return OP_M_REMU;
-                        break;
-                        [[unlikely]] default:
-                        return OP_M_ERROR;
-                        break;
-                }
-            } else {
-                switch (opcode()) {
-                    case M_MULW:
-                        return OP_M_MULW;
-                        break;
-                    case M_DIVW:
-                        return OP_M_DIVW;
-                        break;
-                    case M_DIVUW:
-                        return OP_M_DIVUW;
-                        break;
-                    case M_REMW:
-                        return OP_M_REMW;
-                        break;
-                    case M_REMUW:
-                        return OP_M_REMUW;
-                        break;
-                    [[unlikely]] default:
-                        return OP_M_ERROR;
-                        break;
-
-                }
-            }
-
-            return OP_M_ERROR;
-        }
-
-        inline void dump() const override {
-            std::cout << std::hex << "0x" << this->m_instr << std::dec << std::endl;
-        }
-
         void Exec_M_MUL() const {
             unsigned int rd, rs1, rs2;
             signed_T multiplier, multiplicand;
@@ -146,10 +79,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, static_cast<signed_T>(result));
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.MUL: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, multiplier, multiplicand, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MUL: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, multiplier, multiplicand, rd, result);
         }
 
         void Exec_M_MULH() const;
@@ -180,10 +113,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.DIV: x{:d} / x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.DIV: x{:d} / x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_DIVU() const {
@@ -206,10 +139,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.DIVU: x{:d} / x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.DIVU: x{:d} / x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_REM() const {
@@ -234,10 +167,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.REM: x{:d} % x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.REM: x{:d} % x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_REMU() const {
@@ -260,10 +193,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.REMU: x{:d} % x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.REMU: x{:d} % x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_MULW() const {
@@ -281,10 +214,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.MULW: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, multiplier, multiplicand, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULW: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, multiplier, multiplicand, rd, result);
         }
 
         void Exec_M_DIVW() const {
@@ -309,10 +242,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.DIVW: x{:d} / x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.DIVW: x{:d} / x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_DIVUW() const {
@@ -337,10 +270,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.DIVUW: x{:d} / x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.DIVUW: x{:d} / x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_REMW() const {
@@ -365,10 +298,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.REMW: x{:d} % x{:d} -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, rs2, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.REMW: x{:d} % x{:d} -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, rs2, rd, result);
         }
 
         void Exec_M_REMUW() const {
@@ -391,10 +324,10 @@ namespace riscv_tlm {
 
             this->regs->setValue(rd, result);
 
-            this->logger->debug("{} ns. PC: 0x{:x}. M.REMUW: x{:d}({:d}) % x{:d}({:d}) -> x{:d}({:d})",
-                                sc_core::sc_time_stamp().value(),
-                                this->regs->getPC(),
-                                rs1, dividend, rs2, divisor, rd, result);
+            LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.REMUW: x{:d}({:d}) % x{:d}({:d}) -> x{:d}({:d})",
+                                    sc_core::sc_time_stamp().value(),
+                                    this->regs->getPC(),
+                                    rs1, dividend, rs2, divisor, rd, result);
         }
 
         bool exec_instruction(Instruction &inst, op_M_Codes code) {
@@ -450,17 +383,6 @@ namespace riscv_tlm {
 
             return true;
         }
-
-    private:
-
-        /**
-         * @brief Access to opcode field
-         * @return return opcode field
-         */
-        [[nodiscard]] inline unsigned_T opcode() const override {
-            return static_cast<unsigned_T>(this->m_instr.range(14, 12));
-        }
-
     };
 }
 
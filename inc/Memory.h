@@ -9,8 +9,10 @@
 #ifndef __MEMORY_H__
 #define __MEMORY_H__
 
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #define SC_INCLUDE_DYNAMIC_PROCESSES
 
@@ -22,9 +24,15 @@
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/basic_file_sink.h"
 
+#include "ElfLoader.h"
+
 namespace riscv_tlm {
 /**
  * @brief Basic TLM-2 memory
+ *
+ * Storage is an anonymous mapping reserved at construction time, host
+ * pages are only committed when the guest touches them, so big memories
+ * cost nothing until used.
  */
     class Memory : sc_core::sc_module {
     public:
@@ -33,18 +41,27 @@ namespace riscv_tlm {
 
         /* 16 MBytes */
         enum {
-            SIZE = 0x1000000
+            DEFAULT_SIZE = 0x1000000
         };
         const sc_core::sc_time LATENCY;
 
-        Memory(sc_core::sc_module_name const &name, std::string const &filename);
+        /**
+         * @brief Constructor
+         * @param name module name
+         * @param filename hex or ELF file to load
+         * @param size memory size in bytes
+         * @param base first address of the memory
+         */
+        Memory(sc_core::sc_module_name const &name, std::string const &filename,
+               std::uint64_t size = DEFAULT_SIZE, std::uint64_t base = 0);
 
-        explicit Memory(const sc_core::sc_module_name &name);
+        explicit Memory(const sc_core::sc_module_name &name,
+                        std::uint64_t size = DEFAULT_SIZE, std::uint64_t base = 0);
 
         ~Memory() override;
 
         /**
-         * @brief Returns Program Counter read from hexfile
+         * @brief Returns Program Counter read from hex or ELF file
          * @return Initial PC
          */
         virtual std::uint32_t getPCfromHEX();
@@ -64,12 +81,61 @@ namespace riscv_tlm {
         // *********************************************
         virtual unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
 
+        std::uint64_t getSize() const {
+            return mem_size;
+        }
+
+        std::uint64_t getBase() const {
+            return mem_base;
+        }
+
+        /**
+         * @brief Write non-zero pages to a checkpoint
+         * @param out checkpoint stream
+         */
+        void saveState(std::ostream &out);
+
+        /**
+         * @brief Replace memory contents with the pages of a checkpoint
+         *
+         * Pages are mapped from the file, not read, so they are loaded on
+         * first access.
+         *
+         * @param in checkpoint stream
+         * @param filename checkpoint file name, to map the pages from
+         * @return true on success
+         */
+        bool restoreState(std::istream &in, const std::string &filename);
+
+        /**
+         * @brief Symbols of the program, empty for hex files
+         */
+        const SymbolTable &getSymbols() const {
+            return symbols;
+        }
+
     private:
 
         /**
          * @brief Memory array in bytes
          */
-        std::array<uint8_t, Memory::SIZE> mem{};
+        std::uint8_t *mem;
+
+        /**
+         * @brief Memory size in bytes
+         */
+        std::uint64_t mem_size;
+
+        /**
+         * @brief First address of the memory
+         */
+        std::uint64_t mem_base;
+
+        /**
+         * @brief Pages mapped from a restored checkpoint. They are file
+         * backed, so they may not be resident even if they hold data
+         */
+        std::vector<bool> restored_pages;
 
         /**
          * @brief Log class
@@ -86,6 +152,32 @@ namespace riscv_tlm {
          */
         bool dmi_allowed;
 
+        /**
+         * @brief Reserve host memory
+         */
+        void allocate();
+
+        /**
+         * @brief Check that an access falls inside the memory
+         * @param addr first address accessed
+         * @param len number of bytes
+         * @return true if access is valid
+         */
+        inline bool in_range(std::uint64_t addr, std::uint64_t len) const {
+            return (addr >= mem_base) && (addr - mem_base < mem_size) && (len <= mem_size - (addr - mem_base));
+        }
+
+        /**
+         * @brief Program symbols
+         */
+        SymbolTable symbols;
+
+        /**
+         * @brief Load ELF file segments
+         * @param filename file name to read
+         */
+        void readElfFile(const std::string &filename);
+
         /**
          * @brief Read Intel hex file
          * @param filename file name to read
@@ -18,22 +18,193 @@
 
 #include "memory.h"
 #include <cstdint>
+#include <vector>
 
 namespace riscv_tlm {
 
+    class DecodeCache;
+    class InstrLog;
+
 /**
  * @brief Memory Interface
  */
     class MemoryInterface {
     public:
+        /**
+         * @brief Data access replay, for the JIT differential test
+         */
+        typedef enum {
+            REPLAY_OFF,         /**< plain accesses */
+            REPLAY_RECORD,      /**< accesses are done and recorded */
+            REPLAY_CHECK,       /**< loads return recorded data, stores are compared and dropped */
+        } replay_t;
 
         tlm_utils::simple_initiator_socket<MemoryInterface> data_bus;
 
         MemoryInterface();
 
-        std::uint32_t readDataMem(std::uint64_t addr, int size);
+        std::uint64_t readDataMem(std::uint64_t addr, int size);
+
+        void writeDataMem(std::uint64_t addr, std::uint64_t data, int size);
+
+        /**
+         * @brief Read a block of memory in a single transaction, for the
+         * debugger and memory dumps. Not timed, it can be called outside
+         * any thread
+         * @param addr first address to read
+         * @param data buffer to store data, at least len bytes long
+         * @param len number of bytes to read
+         * @return false if the bus returned an error
+         */
+        bool readDataBurst(std::uint64_t addr, unsigned char *data, unsigned int len);
+
+        /**
+         * @brief Write a block of memory in a single transaction, for the
+         * debugger. Not timed, it can be called outside any thread
+         * @param addr first address to write
+         * @param data data to write, len bytes long
+         * @param len number of bytes to write
+         * @return false if the bus returned an error
+         */
+        bool writeDataBurst(std::uint64_t addr, const unsigned char *data, unsigned int len);
+
+        /**
+         * @brief DMI regions are not longer valid
+         * @param start memory address region start
+         * @param end memory address region end
+         */
+        void invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end);
+
+        /**
+         * @brief Set the decode cache to invalidate on every write
+         * @param cache CPU decode cache
+         */
+        void setDecodeCache(DecodeCache *cache) {
+            decode_cache = cache;
+        }
+
+        /**
+         * @brief Set the CPU quantum keeper, bus accesses are synchronized
+         * with it so devices see the CPU local time
+         * @param qk quantum keeper or nullptr if CPU is not decoupled
+         */
+        void setQuantumKeeper(tlm_utils::tlm_quantumkeeper *qk) {
+            m_qk = qk;
+        }
+
+        /**
+         * @brief Time annotated by devices and not waited for yet. Without
+         * quantum keeper nor fast scheduler the CPU thread waits for it, a bus
+         * access may run outside any thread (e.g. debug session)
+         * @return delay accumulated since last call
+         */
+        sc_core::sc_time takeDelay() {
+            sc_core::sc_time delay = pending_delay;
+            pending_delay = sc_core::SC_ZERO_TIME;
+            return delay;
+        }
+
+        /**
+         * @brief Note data accesses in a commit trace
+         * @param log commit trace, nullptr to stop tracing
+         */
+        void setInstrLog(InstrLog *log) {
+            instr_log = log;
+        }
+
+        /**
+         * @brief Record data accesses, or run them again against the record,
+         * so a code sequence can be executed twice and each device still
+         * sees every access once
+         * @param mode REPLAY_RECORD starts a new record, REPLAY_CHECK goes
+         * back to its first access
+         */
+        void setReplay(replay_t mode) {
+            replay_mode = mode;
+            replay_pos = 0;
+            replay_diverged = false;
+            if (mode == REPLAY_RECORD) {
+                replay_log.clear();
+            }
+        }
+
+        /**
+         * @brief Check the last REPLAY_CHECK run
+         * @return true if it did all recorded accesses, same order, addresses,
+         * sizes and stored data
+         */
+        bool replayMatches() const {
+            return !replay_diverged && (replay_pos == replay_log.size());
+        }
+
+    private:
+        struct replay_access {
+            std::uint64_t addr;
+            std::uint64_t data;
+            int size;
+            bool write;
+        };
+
+        /**
+         * @brief Next access of a REPLAY_CHECK run
+         * @param access access done now, data is ignored for loads
+         * @return data recorded for it, 0 if it does not match the record
+         */
+        std::uint64_t replay(const replay_access &access);
+
+        /**
+         * @brief Host pointer to access data directly, if some DMI region covers it
+         * @param addr address to access to
+         * @param size size of the access in bytes
+         * @param write true for write accesses
+         * @return pointer to data or nullptr if access must go through the bus
+         */
+        inline unsigned char *dmi_pointer(std::uint64_t addr, unsigned int size, bool write) {
+            for (const auto &dmi: dmi_regions) {
+                if ((addr >= dmi.get_start_address()) &&
+                    (addr + size - 1 <= dmi.get_end_address()) &&
+                    (write ? dmi.is_write_allowed() : dmi.is_read_allowed())) {
+                    return dmi.get_dmi_ptr() + (addr - dmi.get_start_address());
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Ask the bus for a DMI region after a transaction allowing it
+         * @param trans transaction just done
+         */
+        void request_dmi(tlm::tlm_generic_payload &trans);
+
+        /**
+         * @brief Send a transaction through the data bus
+         * @param cmd read or write
+         * @param addr first address to access
+         * @param data data buffer
+         * @param len number of bytes
+         * @param timed synchronize with the CPU time and account the delay
+         * annotated by the device
+         * @return false if the bus returned an error
+         */
+        bool bus_access(tlm::tlm_command cmd, std::uint64_t addr, unsigned char *data, unsigned int len,
+                        bool timed);
+
+        /**
+         * @brief Stop simulation on a failed CPU load or store
+         * @param cmd read or write
+         * @param addr address accessed
+         */
+        static void bus_error(tlm::tlm_command cmd, std::uint64_t addr);
 
-        void writeDataMem(std::uint64_t addr, std::uint32_t data, int size);
+        DecodeCache *decode_cache = nullptr;
+        tlm_utils::tlm_quantumkeeper *m_qk = nullptr;
+        InstrLog *instr_log = nullptr;
+        std::vector<tlm::tlm_dmi> dmi_regions;
+        sc_core::sc_time pending_delay;
+        replay_t replay_mode = REPLAY_OFF;
+        std::vector<replay_access> replay_log;
+        std::size_t replay_pos = 0;
+        bool replay_diverged = false;
     };
 }
 #endif /* INC_MEMORYINTERFACE_H_ */
@@ -11,64 +11,89 @@
 
 #define SC_INCLUDE_DYNAMIC_PROCESSES
 
+#include <cstdint>
+#include <ostream>
+
 #include "systemc"
 
 #include "tlm.h"
 
+/* Detailed statistics are compiled in only with -DENABLE_STATS=ON */
+#ifdef ENABLE_STATS
+#define STATS_ENABLED (true)
+#else
+#define STATS_ENABLED (false)
+#endif
+
 /**
  * @brief Performance indicators class
  *
- * Singleton class to be shared among all other classes
+ * One instance per hart, owned by the CPU. The executed instructions count
+ * is always kept (it is cheap, and used by the simulator). The other
+ * counters are in the hot paths, so they are only compiled in when
+ * ENABLE_STATS is defined, otherwise every method is empty.
  */
 class Performance {
 public:
-
 	/**
-	 * @brief Get an instance of the class
-	 * @return pointer to Performance class
+	 * @brief true if detailed statistics are compiled in
 	 */
-	static Performance* getInstance();
+	static constexpr bool enabled = STATS_ENABLED;
+
+	Performance();
 
 	/**
 	 * @brief Increment data memory read counter
 	 */
 	inline void dataMemoryRead() {
-		data_memory_read++;
+		if constexpr (enabled) {
+			data_memory_read++;
+		}
 	}
 
 	/**
 	 * @brief Increment data memory write counter
 	 */
 	inline void dataMemoryWrite() {
-		data_memory_write++;
+		if constexpr (enabled) {
+			data_memory_write++;
+		}
 	}
 
 	/**
 	 * @brief Increment code memory read counter
 	 */
 	inline void codeMemoryRead() {
-		code_memory_read++;
+		if constexpr (enabled) {
+			code_memory_read++;
+		}
 	}
 
 	/**
 	 * @brief Increment code memory write counter
 	 */
 	inline void codeMemoryWrite() {
-		code_memory_write++;
+		if constexpr (enabled) {
+			code_memory_write++;
+		}
 	}
 
 	/**
 	 * @brief Increment register read counter
 	 */
 	inline void registerRead() {
-		register_read++;
+		if constexpr (enabled) {
+			register_read++;
+		}
 	}
 
 	/**
 	 * @brief Increment register write counter
 	 */
 	inline void registerWrite() {
-		register_write++;
+		if constexpr (enabled) {
+			register_write++;
+		}
 	}
 
 	/**
@@ -78,19 +103,215 @@ public:
 		instructions_executed++;
 	}
 
+	/**
+	 * @brief Add several instructions to executed counter
+	 * @param count number of instructions executed
+	 */
+	inline void instructionsInc(unsigned int count) {
+		instructions_executed += count;
+	}
+
+	/**
+	 * @brief Increment executed 16 bits instructions counter
+	 */
+	inline void compressedInstruction() {
+		if constexpr (enabled) {
+			compressed_instructions++;
+		}
+	}
+
+	/**
+	 * @brief Increment executed 32 bits instructions counter
+	 */
+	inline void fullInstruction() {
+		if constexpr (enabled) {
+			full_instructions++;
+		}
+	}
+
+	/**
+	 * @brief Increment load instructions counter
+	 */
+	inline void loadInstruction() {
+		if constexpr (enabled) {
+			loads++;
+		}
+	}
+
+	/**
+	 * @brief Increment store instructions counter
+	 */
+	inline void storeInstruction() {
+		if constexpr (enabled) {
+			stores++;
+		}
+	}
+
+	/**
+	 * @brief Increment conditional branches counter
+	 * @param taken true if the branch was taken
+	 */
+	inline void branchInstruction(bool taken) {
+		if constexpr (enabled) {
+			if (taken) {
+				branches_taken++;
+			} else {
+				branches_not_taken++;
+			}
+		}
+	}
+
+	/**
+	 * @brief Increment CSR instructions counter
+	 */
+	inline void csrInstruction() {
+		if constexpr (enabled) {
+			csr_ops++;
+		}
+	}
+
+	/**
+	 * @brief Increment atomic (A extension) instructions counter
+	 */
+	inline void amoInstruction() {
+		if constexpr (enabled) {
+			amos++;
+		}
+	}
+
+	/**
+	 * @brief Increment decode cache hits counter
+	 */
+	inline void decodeCacheHit() {
+		if constexpr (enabled) {
+			decode_cache_hit++;
+		}
+	}
+
+	/**
+	 * @brief Increment decode cache misses counter
+	 */
+	inline void decodeCacheMiss() {
+		if constexpr (enabled) {
+			decode_cache_miss++;
+		}
+	}
+
+	/**
+	 * @brief Increment basic blocks translated counter
+	 */
+	inline void blockTranslated() {
+		if constexpr (enabled) {
+			blocks_translated++;
+		}
+	}
+
+	/**
+	 * @brief Increment basic blocks executed counter
+	 */
+	inline void blockExecuted() {
+		if constexpr (enabled) {
+			blocks_executed++;
+		}
+	}
+
+	/**
+	 * @brief Increment blocks translated to native code counter
+	 */
+	inline void jitBlockCompiled() {
+		if constexpr (enabled) {
+			jit_blocks_compiled++;
+		}
+	}
+
+	/**
+	 * @brief Increment native blocks executed counter
+	 */
+	inline void jitBlockExecuted() {
+		if constexpr (enabled) {
+			jit_blocks_executed++;
+		}
+	}
+
+	/**
+	 * @brief Increment instruction pairs executed in a single step counter
+	 */
+	inline void fusedPair() {
+		if constexpr (enabled) {
+			fused_pairs++;
+		}
+	}
+
+	/**
+	 * @brief Increment blocks entered through a direct link counter
+	 */
+	inline void blockLinkHit() {
+		if constexpr (enabled) {
+			block_link_hit++;
+		}
+	}
+
+	/**
+	 * @brief Increment direct links not set up yet (or not followed) counter
+	 */
+	inline void blockLinkMiss() {
+		if constexpr (enabled) {
+			block_link_miss++;
+		}
+	}
+
+	/**
+	 * @brief Increment indirect jumps found in the inline target cache counter
+	 */
+	inline void indirectHit() {
+		if constexpr (enabled) {
+			indirect_hit++;
+		}
+	}
+
+	/**
+	 * @brief Increment indirect jumps missed in the inline target cache counter
+	 */
+	inline void indirectMiss() {
+		if constexpr (enabled) {
+			indirect_miss++;
+		}
+	}
+
+	/**
+	 * @brief Increment returns predicted by the return address stack counter
+	 */
+	inline void returnHit() {
+		if constexpr (enabled) {
+			return_hit++;
+		}
+	}
+
+	/**
+	 * @brief Increment returns mispredicted by the return address stack counter
+	 */
+	inline void returnMiss() {
+		if constexpr (enabled) {
+			return_miss++;
+		}
+	}
+
 	/**
 	 * @brief Dump counters to cout
 	 */
 	void dump() const;
 
+	/**
+	 * @brief Dump counters as a JSON object
+	 * @param out stream to write to
+	 */
+	void dumpJSON(std::ostream &out) const;
+
 	inline uint_fast64_t getInstructions() const {
 	  return instructions_executed;
 	}
 
 private:
-	static Performance *instance;
-	Performance();
-
 	uint_fast64_t data_memory_read;
 	uint_fast64_t data_memory_write;
 	uint_fast64_t code_memory_read;
@@ -98,6 +319,27 @@ private:
 	uint_fast64_t register_read;
 	uint_fast64_t register_write;
 	uint_fast64_t instructions_executed;
+	uint_fast64_t compressed_instructions;
+	uint_fast64_t full_instructions;
+	uint_fast64_t loads;
+	uint_fast64_t stores;
+	uint_fast64_t branches_taken;
+	uint_fast64_t branches_not_taken;
+	uint_fast64_t csr_ops;
+	uint_fast64_t amos;
+	uint_fast64_t decode_cache_hit;
+	uint_fast64_t decode_cache_miss;
+	uint_fast64_t blocks_translated;
+	uint_fast64_t blocks_executed;
+	uint_fast64_t jit_blocks_compiled;
+	uint_fast64_t jit_blocks_executed;
+	uint_fast64_t fused_pairs;
+	uint_fast64_t block_link_hit;
+	uint_fast64_t block_link_miss;
+	uint_fast64_t indirect_hit;
+	uint_fast64_t indirect_miss;
+	uint_fast64_t return_hit;
+	uint_fast64_t return_miss;
 };
 
 #endif
@@ -11,12 +11,16 @@
 
 #define SC_INCLUDE_DYNAMIC_PROCESSES
 
+#include <array>
+#include <cstdint>
 #include <iomanip>
-#include <unordered_map>
 
 #include "systemc"
 #include "tlm.h"
 
+#include "Checkpoint.h"
+#include "FastScheduler.h"
+#include "InstrLog.h"
 #include "Performance.h"
 #include "Memory.h"
 
@@ -70,7 +74,7 @@ namespace riscv_tlm {
 
 #define CSR_CYCLEH (0xC80)
 #define CSR_TIMEH (0xC81)
-#define CSR_INSTRETH (0xC02)
+#define CSR_INSTRETH (0xC82)
 
 #define CSR_STVEC (0x105)
 
@@ -111,9 +115,70 @@ namespace riscv_tlm {
 #define MIE_SEIE (1 << 9)
 #define MIE_MEIE (1 << 11)
 
-/* 1 ns tick in CYCLE & TIME counters */
+/* Bits of MIE and MIP software can write, M and S levels */
+#define MIE_WRITE_MASK (MIE_SSIE | MIE_MSIE | MIE_STIE | MIE_MTIE | MIE_SEIE | MIE_MEIE)
+#define MIP_WRITE_MASK (MIP_SSIP | MIP_STIP | MIP_SEIP)
+
+/* 1 ns tick in TIME counter */
 #define TICKS_PER_SECOND (1000000)
 
+/* Counter selected by the low bits of a counter CSR number */
+#define COUNTER_CYCLE (0)
+#define COUNTER_TIME (1)
+#define COUNTER_INSTRET (2)
+#define COUNTER_INDEX_MASK (0x1F)
+
+    /**
+     * @brief Side effects of CSR accesses
+     */
+    typedef enum : std::uint8_t {
+        CSR_KIND_RW = 0,    /**< plain storage */
+        CSR_KIND_RO,        /**< writes are ignored */
+        CSR_KIND_COUNTER,   /**< read-only counter, lower XLEN bits */
+        CSR_KIND_COUNTERH,  /**< read-only counter, upper 32 bits (RV32 only) */
+        CSR_KIND_MCOUNTER,  /**< writable machine counter, lower XLEN bits */
+        CSR_KIND_MCOUNTERH, /**< writable machine counter, upper 32 bits (RV32 only) */
+        CSR_KIND_MASKED,    /**< only some bits are writable, see csr_write_mask() */
+        CSR_KIND_STATUS,    /**< plain storage, holds the global interrupt enable */
+    } csr_kind_t;
+
+    /**
+     * @brief Build the CSR kind table at compile time
+     * @return kind of each of the 4096 CSRs
+     */
+    constexpr std::array<csr_kind_t, 4096> make_csr_kinds() {
+        std::array<csr_kind_t, 4096> kinds{};
+
+        /* @FIXME: rv32mi-p-ma_fetch tests doesn't allow MISA to be writable,
+         * but Volume II: Privileged Architecture v1.10 says MISA is writable (?)
+         */
+        kinds[CSR_MISA] = CSR_KIND_RO;
+        kinds[CSR_MVENDORID] = CSR_KIND_RO;
+        kinds[CSR_MARCHID] = CSR_KIND_RO;
+        kinds[CSR_MIMPID] = CSR_KIND_RO;
+        kinds[CSR_MHARTID] = CSR_KIND_RO;
+
+        kinds[CSR_CYCLE] = CSR_KIND_COUNTER;
+        kinds[CSR_TIME] = CSR_KIND_COUNTER;
+        kinds[CSR_INSTRET] = CSR_KIND_COUNTER;
+        kinds[CSR_CYCLEH] = CSR_KIND_COUNTERH;
+        kinds[CSR_TIMEH] = CSR_KIND_COUNTERH;
+        kinds[CSR_INSTRETH] = CSR_KIND_COUNTERH;
+
+        kinds[CSR_MCYCLE] = CSR_KIND_MCOUNTER;
+        kinds[CSR_MINSTRET] = CSR_KIND_MCOUNTER;
+        kinds[CSR_MCYCLEH] = CSR_KIND_MCOUNTERH;
+        kinds[CSR_MINSTRETH] = CSR_KIND_MCOUNTERH;
+
+        kinds[CSR_MIE] = CSR_KIND_MASKED;
+        kinds[CSR_MIP] = CSR_KIND_MASKED;
+        kinds[CSR_MSTATUS] = CSR_KIND_STATUS;
+
+        return kinds;
+    }
+
+    inline constexpr std::array<csr_kind_t, 4096> csr_kinds = make_csr_kinds();
+
 /**
  * @brief Register file implementation
  */
@@ -190,13 +255,14 @@ namespace riscv_tlm {
         };
 
         /**
-         * Default constructor
+         * Constructor
+         * @param performance statistics of the hart
          */
-        Registers() {
-            perf = Performance::getInstance();
+        explicit Registers(Performance *performance) {
+            perf = performance;
 
             initCSR();
-            register_bank[sp] = Memory::SIZE - 4; // default stack at the end of the memory
+            register_bank[sp] = Memory::DEFAULT_SIZE - 4; // default stack at the end of the memory
             register_PC = 0x80000000;       // default _start address
         };
 
@@ -209,6 +275,11 @@ namespace riscv_tlm {
             if ((reg_num != 0) && (reg_num < 32)) {
                 register_bank[reg_num] = value;
                 perf->registerWrite();
+                if constexpr (InstrLog::enabled) {
+                    if (instr_log != nullptr) {
+                        instr_log->noteWrite(reg_num, value);
+                    }
+                }
             }
         }
 
@@ -227,6 +298,22 @@ namespace riscv_tlm {
             }
         }
 
+        /**
+         * @brief Raw access to the register bank, for translated code
+         * @return pointer to x0
+         */
+        T *getRawRegisters() {
+            return register_bank.data();
+        }
+
+        /**
+         * @brief Raw access to PC, for translated code
+         * @return pointer to PC
+         */
+        T *getRawPC() {
+            return &register_PC;
+        }
+
         /**
          * Returns PC value
          * @return PC value
@@ -259,41 +346,19 @@ namespace riscv_tlm {
          * @param csr CSR number to access
          * @return CSR value
          */
-        T getCSR(int csr) {
-            T ret_value;
-
-            switch (csr) {
-                case CSR_CYCLE:
-                case CSR_MCYCLE:
-                    ret_value = static_cast<std::uint64_t>(sc_core::sc_time(
-                            sc_core::sc_time_stamp()
-                            - sc_core::sc_time(sc_core::SC_ZERO_TIME)).to_double())
-                                & 0x00000000FFFFFFFF;
-                    break;
-                case CSR_CYCLEH:
-                case CSR_MCYCLEH:
-                    ret_value = static_cast<std::uint32_t>((std::uint64_t) (sc_core::sc_time(
-                            sc_core::sc_time_stamp()
-                            - sc_core::sc_time(sc_core::SC_ZERO_TIME)).to_double())
-                                                                   >> 32 & 0x00000000FFFFFFFF);
-                    break;
-                case CSR_TIME:
-                    ret_value = static_cast<std::uint64_t>(sc_core::sc_time(
-                            sc_core::sc_time_stamp()
-                            - sc_core::sc_time(sc_core::SC_ZERO_TIME)).to_double())
-                                & 0x00000000FFFFFFFF;
-                    break;
-                case CSR_TIMEH:
-                    ret_value = static_cast<std::uint32_t>((std::uint64_t) (sc_core::sc_time(
-                            sc_core::sc_time_stamp()
-                            - sc_core::sc_time(sc_core::SC_ZERO_TIME)).to_double())
-                                                                   >> 32 & 0x00000000FFFFFFFF);
-                    break;
-                    [[likely]] default:
-                    ret_value = CSR[csr];
-                    break;
+        T getCSR(int csr) const {
+            /* CSR space is 12 bits, callers like the debugger pass any number */
+            csr &= 0xFFF;
+            switch (csr_kinds[csr]) {
+                case CSR_KIND_COUNTER:
+                case CSR_KIND_MCOUNTER:
+                    return static_cast<T>(getCounter(csr));
+                case CSR_KIND_COUNTERH:
+                case CSR_KIND_MCOUNTERH:
+                    return static_cast<T>(getCounter(csr) >> 32);
+                [[likely]] default:
+                    return CSR[csr];
             }
-            return ret_value;
         }
 
         /**
@@ -302,19 +367,189 @@ namespace riscv_tlm {
          * @param value new value to register
          */
         void setCSR(int csr, T value) {
-            /* @FIXME: rv32mi-p-ma_fetch tests doesn't allow MISA to be writable,
-             * but Volume II: Privileged Architecture v1.10 says MISA is writable (?)
-             */
-            if (csr != CSR_MISA) {
-                CSR[csr] = value;
+            csr &= 0xFFF;
+            switch (csr_kinds[csr]) {
+                [[likely]] case CSR_KIND_RW:
+                    CSR[csr] = value;
+                    break;
+                case CSR_KIND_MASKED: {
+                    T mask = csr_write_mask(csr);
+                    CSR[csr] = (CSR[csr] & ~mask) | (value & mask);
+                    update_irq();
+                    break;
+                }
+                case CSR_KIND_STATUS:
+                    CSR[csr] = value;
+                    update_irq();
+                    break;
+                case CSR_KIND_MCOUNTER: {
+                    std::uint64_t &counter = (csr == CSR_MCYCLE) ? cycles : instret;
+                    if constexpr (sizeof(T) == 4) {
+                        counter = (counter & 0xFFFFFFFF00000000) | value;
+                    } else {
+                        counter = value;
+                    }
+                    counter -= retire_step(csr);
+                    break;
+                }
+                case CSR_KIND_MCOUNTERH: {
+                    std::uint64_t &counter = (csr == CSR_MCYCLEH) ? cycles : instret;
+                    counter = (counter & 0x00000000FFFFFFFF) | (static_cast<std::uint64_t>(value) << 32);
+                    counter -= retire_step(csr);
+                    break;
+                }
+                default:
+                    /* Read-only */
+                    break;
             }
         }
 
+        /**
+         * @brief Set an interrupt pending, for interrupt sources (most MIP
+         * bits are read-only for software)
+         * @param mask MIP bit(s) to set
+         */
+        void raiseIRQ(T mask) {
+            CSR[CSR_MIP] |= mask;
+            update_irq();
+        }
+
+        /**
+         * @brief Clear a pending interrupt
+         * @param mask MIP bit(s) to clear
+         */
+        void clearIRQ(T mask) {
+            CSR[CSR_MIP] &= ~mask;
+            update_irq();
+        }
+
+        /**
+         * @brief Interrupts that can be taken now
+         * @return MIP & MIE, or 0 if interrupts are globally disabled
+         */
+        inline T getIRQPending() const {
+            return irq_pending;
+        }
+
+        /**
+         * @brief Account retired instructions in minstret and mcycle
+         * @param count number of instructions retired
+         */
+        inline void retire(std::uint64_t count) {
+            instret += count;
+            cycles += count * cycles_per_instruction;
+        }
+
+        /**
+         * @brief Note register writes in a commit trace
+         * @param log commit trace, nullptr to stop tracing
+         */
+        void setInstrLog(InstrLog *log) {
+            instr_log = log;
+        }
+
+        /**
+         * @brief Extensions reported by misa, initialized with all of them
+         * @param extensions MISA_x_EXTENSION bits implemented by the hart
+         */
+        void setISA(T extensions) {
+            CSR[CSR_MISA] = (CSR[CSR_MISA] & ~static_cast<T>(0x3FFFFFF)) | MISA_I_BASE | extensions;
+        }
+
+        /**
+         * @brief Set the timing model of mcycle
+         * @param cpi cycles added to mcycle by each retired instruction
+         */
+        void setCyclesPerInstruction(unsigned int cpi) {
+            cycles_per_instruction = cpi;
+        }
+
         /**
          * Dump register data to console
          */
         void dump() const;
 
+        /**
+         * @brief Copy the state of another register bank, for the JIT differential test
+         * @param other register bank to copy from
+         * @param csrs copy CSRs too, not needed if none was written since both were equal
+         */
+        void copyState(const Registers &other, bool csrs) {
+            register_bank = other.register_bank;
+            register_PC = other.register_PC;
+            cycles = other.cycles;
+            instret = other.instret;
+            if (csrs) {
+                CSR = other.CSR;
+                irq_pending = other.irq_pending;
+            }
+        }
+
+        /**
+         * @brief Compare with another register bank, for the JIT differential test
+         * @param other register bank to compare with
+         * @param csrs compare CSRs too
+         * @return true if registers, PC, counters and CSRs (if requested) are equal
+         */
+        bool sameState(const Registers &other, bool csrs) const {
+            return (register_bank == other.register_bank) && (register_PC == other.register_PC) &&
+                   (cycles == other.cycles) && (instret == other.instret) && (!csrs || (CSR == other.CSR));
+        }
+
+        /**
+         * @brief Write registers, PC and CSRs to a checkpoint
+         * @param out checkpoint stream
+         */
+        void save(std::ostream &out) const {
+            for (auto reg : register_bank) {
+                Checkpoint::put<std::uint64_t>(out, reg);
+            }
+            Checkpoint::put<std::uint64_t>(out, register_PC);
+
+            /* Most CSRs are 0, only the others are saved */
+            std::uint32_t count = 0;
+            for (auto value : CSR) {
+                count += (value != 0);
+            }
+
+            Checkpoint::put<std::uint32_t>(out, count);
+            for (std::uint32_t csr = 0; csr < CSR.size(); csr++) {
+                if (CSR[csr] != 0) {
+                    Checkpoint::put<std::uint32_t>(out, csr);
+                    Checkpoint::put<std::uint64_t>(out, CSR[csr]);
+                }
+            }
+
+            Checkpoint::put<std::uint64_t>(out, cycles);
+            Checkpoint::put<std::uint64_t>(out, instret);
+        }
+
+        /**
+         * @brief Read registers written by save()
+         * @param in checkpoint stream
+         */
+        void restore(std::istream &in) {
+            for (auto &reg : register_bank) {
+                reg = Checkpoint::get<std::uint64_t>(in);
+            }
+            register_PC = Checkpoint::get<std::uint64_t>(in);
+
+            CSR.fill(0);
+            auto count = Checkpoint::get<std::uint32_t>(in);
+            for (std::uint32_t i = 0; (i < count) && in.good(); i++) {
+                auto csr = Checkpoint::get<std::uint32_t>(in);
+                auto value = Checkpoint::get<std::uint64_t>(in);
+                if (csr < CSR.size()) {
+                    CSR[csr] = value;
+                }
+            }
+
+            cycles = Checkpoint::get<std::uint64_t>(in);
+            instret = Checkpoint::get<std::uint64_t>(in);
+
+            update_irq();
+        }
+
     private:
         /**
          * bank of registers (32 regs of 32bits each)
@@ -327,11 +562,60 @@ namespace riscv_tlm {
         T register_PC;
 
         /**
-         * CSR registers (4096 maximum)
+         * CSR registers (4096 maximum), indexed by CSR number
+         */
+        std::array<T, 4096> CSR = {{0}};
+
+        /**
+         * mcycle and minstret, 64 bits in both RV32 and RV64
          */
-        std::unordered_map<T, unsigned int> CSR;
+        std::uint64_t cycles = 0;
+        std::uint64_t instret = 0;
+        unsigned int cycles_per_instruction = 1;
+
+        /**
+         * MIP & MIE when MSTATUS.MIE is set, 0 otherwise. Updated on writes
+         * to these CSRs, so checking for interrupts is a single load
+         */
+        T irq_pending = 0;
 
         Performance *perf;
+        InstrLog *instr_log = nullptr;
+
+        /**
+         * @brief Current value of a counter CSR (any of its aliases)
+         * @param csr CSR number, cycle, time or instret family
+         * @return 64 bits counter value
+         */
+        std::uint64_t getCounter(int csr) const {
+            switch (csr & COUNTER_INDEX_MASK) {
+                case COUNTER_CYCLE:
+                    return cycles;
+                case COUNTER_INSTRET:
+                    return instret;
+                default:
+                    return FastScheduler::time_stamp();
+            }
+        }
+
+        /**
+         * @brief Amount a counter CSR moves when the writing instruction
+         * retires. Written value must be the one the next instruction reads
+         */
+        std::uint64_t retire_step(int csr) const {
+            return ((csr & COUNTER_INDEX_MASK) == COUNTER_CYCLE) ? cycles_per_instruction : 1;
+        }
+
+        /**
+         * @brief Writable bits of a CSR_KIND_MASKED CSR
+         */
+        static constexpr T csr_write_mask(int csr) {
+            return (csr == CSR_MIE) ? MIE_WRITE_MASK : MIP_WRITE_MASK;
+        }
+
+        void update_irq() {
+            irq_pending = (CSR[CSR_MSTATUS] & MSTATUS_MIE) ? (CSR[CSR_MIP] & CSR[CSR_MIE]) : 0;
+        }
 
         void initCSR();
     };
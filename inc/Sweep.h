@@ -0,0 +1,85 @@
+/*!
+ \file Sweep.h
+ \brief Run many variants of a simulation from a common state
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_SWEEP_H_
+#define INC_SWEEP_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace riscv_tlm {
+
+    /**
+     * @brief Parameter sweep using process fork()
+     *
+     * The parent simulation runs up to some point (e.g. end of boot) and
+     * then forks one child process per variant. Children share the whole
+     * simulator state, guest memory included, copy-on-write, and go on
+     * with the simulation. Each child reports its result to the parent
+     * through a pipe when it finishes.
+     */
+    class Sweep {
+    public:
+        /**
+         * @brief Result of one variant, sent from child to parent
+         */
+        struct variant_result {
+            std::uint32_t variant;
+            std::int32_t status;            /**< exit code, or -signal if child was killed */
+            std::uint64_t instructions;     /**< instructions executed after the fork */
+            std::uint64_t sim_time;         /**< simulated time at the end, in ns */
+            std::uint64_t signature_hash;   /**< FNV-1a of the memory dump, 0 if none */
+        };
+
+        /**
+         * @brief Constructor
+         * @param variants number of children to run
+         * @param jobs maximum number of children running at the same time
+         */
+        Sweep(unsigned int variants, unsigned int jobs);
+
+        /**
+         * @brief Fork all variants, must be called between instructions
+         * @return variant number in the children, -1 in the parent once all
+         * children have finished
+         */
+        int fork_variants();
+
+        /**
+         * @brief Send the result of this variant to the parent
+         * @param result variant result
+         */
+        void report(const variant_result &result);
+
+        /**
+         * @brief Print results of all variants
+         */
+        void dump() const;
+
+        bool isChild() const {
+            return variant >= 0;
+        }
+
+        int getVariant() const {
+            return variant;
+        }
+
+        const std::vector<variant_result> &getResults() const {
+            return results;
+        }
+
+    private:
+        unsigned int variants;
+        unsigned int jobs;
+        int variant;                /**< this process variant, -1 for the parent */
+        int result_fd;              /**< pipe to the parent, children only */
+        std::vector<variant_result> results;
+    };
+}
+
+#endif /* INC_SWEEP_H_ */
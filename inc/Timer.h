@@ -21,6 +21,7 @@
 #include "tlm_utils/simple_target_socket.h"
 
 #include "BusCtrl.h"
+#include "Performance.h"
 
 namespace riscv_tlm::peripherals {
 /**
@@ -63,10 +64,67 @@ namespace riscv_tlm::peripherals {
         virtual void b_transport(tlm::tlm_generic_payload &trans,
                                  sc_core::sc_time &delay);
 
+        /**
+         * @brief Write mtime and mtimecmp to a checkpoint
+         * @param out checkpoint stream
+         */
+        void saveState(std::ostream &out);
+
+        /**
+         * @brief Read state written by saveState(), before simulation starts
+         * @param in checkpoint stream
+         * @return true on success
+         */
+        bool restoreState(std::istream &in);
+
+        /**
+         * @brief Enable the polling loop detector
+         *
+         * When the guest keeps reading mtime in a tight loop, each read is
+         * annotated with skip ns of delay, so simulation time runs ahead
+         * without executing the loop. Time never jumps over mtimecmp.
+         *
+         * @param skip time added to each polling read, 0 disables it
+         * @param hart statistics of the polling CPU, for its instruction count
+         */
+        void setSpinSkip(std::uint64_t skip, const Performance *hart) {
+            spin_skip = skip;
+            perf = hart;
+        }
+
     private:
+        enum {
+            SPIN_THRESHOLD = 8,     /**< polls in a row before skipping time */
+            SPIN_WINDOW = 64,       /**< max. instructions between two polls of a loop */
+        };
+
+        /**
+         * @brief Track mtime reads and compute the time to skip
+         * @return delay to annotate to the current read
+         */
+        sc_core::sc_time spin_delay();
+
+        /**
+         * @brief Post timer_event, to the FastScheduler in fast mode
+         * @param delay time from now to the event
+         */
+        void schedule_event(std::uint64_t delay);
+
+        /**
+         * @brief Send the timer interrupt to the CPU
+         */
+        void raise_irq();
+
         sc_dt::sc_uint<64> m_mtime; /**< mtime register */
         sc_dt::sc_uint<64> m_mtimecmp; /**< mtimecmp register */
         sc_core::sc_event timer_event; /**< event */
+        std::uint64_t time_offset; /**< mtime value at simulation start (restored checkpoint) */
+        sc_core::sc_time restored_event; /**< pending timer_event of a restored checkpoint */
+        std::uint64_t event_id; /**< last event posted to the FastScheduler, older ones are stale */
+        std::uint64_t spin_skip; /**< time skipped by each polling read, 0 if disabled */
+        unsigned int spin_polls; /**< consecutive polls of mtime */
+        std::uint64_t last_poll; /**< instruction count at the last poll */
+        const Performance *perf; /**< instruction count source of the detector */
     };
 }
 #endif
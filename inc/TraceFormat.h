@@ -0,0 +1,120 @@
+/*!
+ \file TraceFormat.h
+ \brief Binary commit trace file format, shared by the simulator and trace_decode
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INC_TRACEFORMAT_H_
+#define INC_TRACEFORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace riscv_tlm::trace {
+
+    /**
+     * File layout:
+     *
+     *  - file_header
+     *  - blocks: block_header followed by stored_size bytes. The block is
+     *    compressed with the file codec, unless stored_size == raw_size.
+     *
+     * A block holds whole records and the delta state is reset at the start
+     * of each block, so blocks can be decoded independently.
+     *
+     * Record: flags byte, then the fields present in that order:
+     *  - FLAG_JUMP: zigzag varint, PC minus the PC following the previous
+     *    record (0 at block start)
+     *  - instruction: 2 bytes if FLAG_COMPRESSED, 4 bytes otherwise
+     *  - FLAG_RD: destination register byte, varint value written
+     *  - FLAG_MEM: zigzag varint, address minus previous access address,
+     *    access size byte, varint data read or written (FLAG_STORE)
+     *
+     * All fixed size fields are little endian.
+     */
+    enum {
+        VERSION = 2,
+        BLOCK_SIZE = 1 << 20,       /**< raw bytes in a block before it is written */
+        MAX_RECORD_SIZE = 48,
+    };
+
+    enum : std::uint8_t {
+        FLAG_JUMP = 1 << 0,
+        FLAG_COMPRESSED = 1 << 1,
+        FLAG_RD = 1 << 2,
+        FLAG_MEM = 1 << 3,
+        FLAG_STORE = 1 << 4,
+    };
+
+    typedef enum : std::uint8_t {
+        CODEC_NONE = 0,
+        CODEC_LZ4 = 1,
+        CODEC_ZSTD = 2,
+    } codec_t;
+
+    struct file_header {
+        char magic[8];              /**< "RVTLMTRC" */
+        std::uint32_t version;
+        std::uint8_t xlen;          /**< 32 or 64 */
+        codec_t codec;
+        std::uint16_t reserved;
+    };
+
+    struct block_header {
+        std::uint32_t raw_size;     /**< bytes of records */
+        std::uint32_t stored_size;  /**< bytes following this header */
+        std::uint32_t records;      /**< number of records in the block */
+    };
+
+    inline std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    inline std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    /**
+     * @brief Write an LEB128 unsigned value
+     * @param out buffer, at least 10 bytes available
+     * @return bytes written
+     */
+    inline std::size_t put_varint(std::uint8_t *out, std::uint64_t value) {
+        std::size_t len = 0;
+
+        while (value >= 0x80) {
+            out[len++] = static_cast<std::uint8_t>(value) | 0x80;
+            value >>= 7;
+        }
+        out[len++] = static_cast<std::uint8_t>(value);
+        return len;
+    }
+
+    /**
+     * @brief Read an LEB128 unsigned value
+     * @param in buffer
+     * @param end end of the buffer
+     * @param value read value
+     * @return bytes read, 0 if the buffer ends before the value
+     */
+    inline std::size_t get_varint(const std::uint8_t *in, const std::uint8_t *end, std::uint64_t *value) {
+        std::uint64_t result = 0;
+        std::size_t len = 0;
+        unsigned int shift = 0;
+
+        while ((in + len < end) && (shift < 64)) {
+            std::uint8_t byte = in[len++];
+            result |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                *value = result;
+                return len;
+            }
+            shift += 7;
+        }
+        return 0;
+    }
+}
+
+#endif
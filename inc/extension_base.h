@@ -11,6 +11,8 @@
 
 #include "systemc"
 
+#include "InstrFields.h"
+#include "InstrLog.h"
 #include "Instruction.h"
 #include "Registers.h"
 #include "MemoryInterface.h"
@@ -46,17 +48,17 @@ namespace riscv_tlm {
 
     public:
         extension_base(const T &instr, Registers<T> *register_bank,
-                       MemoryInterface *mem_interface) :
-                m_instr(instr), regs(register_bank), mem_intf(mem_interface) {
+                       MemoryInterface *mem_interface, Performance *performance) :
+                m_instr(static_cast<std::uint32_t>(instr)), regs(register_bank), perf(performance),
+                mem_intf(mem_interface) {
 
-            perf = Performance::getInstance();
             logger = spdlog::get("my_logger");
         }
 
         virtual ~extension_base() = default;
 
         void setInstr(std::uint32_t p_instr) {
-            m_instr = sc_dt::sc_uint<32>(p_instr);
+            m_instr = p_instr;
         }
 
         void RaiseException(Exception_cause cause, std::uint32_t inst) {
@@ -84,63 +86,56 @@ namespace riscv_tlm {
             regs->setCSR(CSR_MSTATUS, m_cause);
             regs->setPC(new_pc);
 
-            logger->debug("{} ns. PC: 0x{:x}. Exception! new PC 0x{:x} ", sc_core::sc_time_stamp().value(),
-                          current_pc, new_pc);
+            LOG_INSTR(logger, "{} ns. PC: 0x{:x}. Exception! new PC 0x{:x} ", sc_core::sc_time_stamp().value(),
+                              current_pc, new_pc);
 
         }
 
         bool NOP() {
-            logger->debug("{} ns. PC: 0x{:x}. NOP! new PC 0x{:x} ", sc_core::sc_time_stamp().value(), regs->getPC(), regs->getPC() + 4);
+            LOG_INSTR(logger, "{} ns. PC: 0x{:x}. NOP! new PC 0x{:x} ", sc_core::sc_time_stamp().value(), regs->getPC(), regs->getPC() + 4);
             logger->flush();
             sc_core::sc_stop();
             return true;
         }
 
-        /* pure virtual functions */
-        virtual unsigned_T opcode() const = 0;
-
-        virtual unsigned int get_rd() const {
-            return m_instr.range(11, 7);
-        }
-
-        virtual void set_rd(unsigned int value) {
-            m_instr.range(11, 7) = value;
-        }
-
-        virtual unsigned int get_rs1() const {
-            return m_instr.range(19, 15);
+        /**
+         * @brief Access to rd field
+         * @return rd field
+         */
+        inline unsigned int get_rd() const {
+            return fields::rd(m_instr);
         }
 
-        virtual void set_rs1(unsigned int value) {
-            m_instr.range(19, 15) = value;
+        /**
+         * @brief Access to rs1 field
+         * @return rs1 field
+         */
+        inline unsigned int get_rs1() const {
+            return fields::rs1(m_instr);
         }
 
-        virtual unsigned int get_rs2() const {
-            return m_instr.range(24, 20);
+        /**
+         * @brief Access to rs2 field
+         * @return rs2 field
+         */
+        inline unsigned int get_rs2() const {
+            return fields::rs2(m_instr);
         }
 
-        virtual void set_rs2(unsigned int value) {
-            m_instr.range(24, 20) = value;
+        /**
+         * @brief Access to funct3 field
+         * @return funct3 field
+         */
+        inline unsigned int get_funct3() const {
+            return fields::funct3(m_instr);
         }
 
-        virtual unsigned int get_funct3() const {
-            return m_instr.range(14, 12);
-        }
-
-        virtual void set_funct3(unsigned int value) {
-            m_instr.range(14, 12) = value;
-        }
-
-        // For RV64 SLLI, SRLI & SRAI
-        virtual unsigned int get_shamt_slli() const {
-            return m_instr.range(25, 20);
-        }
-        virtual void dump() const {
+        void dump() const {
             std::cout << std::hex << "0x" << m_instr << std::dec << std::endl;
         }
 
     protected:
-        sc_dt::sc_uint<32> m_instr;
+        std::uint32_t m_instr;
         Registers<T> *regs;
         Performance *perf;
         MemoryInterface *mem_intf;
@@ -11,72 +11,6 @@
 namespace riscv_tlm {
 
     ///// RV32 Specialization
-    template<>
-    std::int32_t BASE_ISA<std::uint32_t>::get_imm_I() const {
-        std::uint32_t aux = 0;
-
-        aux = this->m_instr.range(31, 20);
-
-        /* sign extension (optimize) */
-        if (this->m_instr[31] == 1) {
-            aux |= (0b11111111111111111111) << 12;
-        }
-
-        return static_cast<std::int32_t>(aux);
-    }
-
-    template<>
-    std::int32_t BASE_ISA<std::uint32_t>::get_imm_S() const {
-        std::uint32_t aux = 0;
-
-        aux = this->m_instr.range(31, 25) << 5;
-        aux |= this->m_instr.range(11, 7);
-
-        if (this->m_instr[31] == 1) {
-            aux |= (0b11111111111111111111) << 12;
-        }
-
-        return static_cast<std::int32_t>(aux);
-    }
-
-    template<>
-    std::int32_t BASE_ISA<std::uint32_t>::get_imm_B() const {
-        std::uint32_t aux = 0;
-
-        aux |= this->m_instr[7] << 11;
-        aux |= this->m_instr.range(30, 25) << 5;
-        aux |= this->m_instr[31] << 12;
-        aux |= this->m_instr.range(11, 8) << 1;
-
-        if (this->m_instr[31] == 1) {
-            aux |= (0b11111111111111111111) << 12;
-        }
-
-        return static_cast<std::int32_t>(aux);
-    }
-
-    template<>
-    std::int32_t BASE_ISA<std::uint32_t>::get_imm_J() const {
-        std::uint32_t aux = 0;
-
-        aux = this->m_instr[31] << 20;
-        aux |= this->m_instr.range(19, 12) << 12;
-        aux |= this->m_instr[20] << 11;
-        aux |= this->m_instr.range(30, 21) << 1;
-
-        /* bit extension (better way to do that?) */
-        if (this->m_instr[31] == 1) {
-            aux |= (0b111111111111) << 20;
-        }
-
-        return static_cast<std::int32_t>(aux);
-    }
-
-    template<>
-    std::uint32_t BASE_ISA<std::uint32_t>::get_funct7b() const {
-        return this->m_instr.range(31, 25);
-    }
-
     // SLLI, SRLI and SRAI get different shamt field depending on RV32 or RV64
     template<>
     bool BASE_ISA<std::uint32_t>::Exec_SLLI() {
@@ -101,10 +35,10 @@ namespace riscv_tlm {
         calc = static_cast<unsigned_T>(this->regs->getValue(rs1)) << shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SLLI: x{:d} << {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLLI: x{:d} << {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -124,10 +58,10 @@ namespace riscv_tlm {
         calc = static_cast<unsigned_T>(this->regs->getValue(rs1)) >> shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRLI: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRLI: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -147,10 +81,10 @@ namespace riscv_tlm {
         calc = static_cast<signed_T>(this->regs->getValue(rs1)) >> shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRAI: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRAI: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -170,10 +104,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRL: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRL: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -192,10 +126,10 @@ namespace riscv_tlm {
         calc = static_cast<signed_T>(this->regs->getValue(rs1)) >> shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRA: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRA: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -215,84 +149,15 @@ namespace riscv_tlm {
         calc = this->regs->getValue(rs1) << shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SLL: x{:d} << x{:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLL: x{:d} << x{:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
 
     ///// RV64 Specialization
-    template<>
-    std::int64_t BASE_ISA<std::uint64_t>::get_imm_I() const {
-        std::uint64_t aux = 0;
-
-        aux = this->m_instr.range(31, 20);
-
-        /* sign extension (optimize) */
-        if (this->m_instr[31] == 1) {
-            aux |= (0b11111111111111111111) << 12;
-            aux |= 0xFFFFFFFFULL << 32;
-        }
-
-        return static_cast<std::int64_t>(aux);
-    }
-
-    template<>
-    std::int64_t BASE_ISA<std::uint64_t>::get_imm_S() const {
-        std::uint64_t aux = 0;
-
-        aux = this->m_instr.range(31, 25) << 5;
-        aux |= this->m_instr.range(11, 7);
-
-        if (this->m_instr[31] == 1) {
-            aux |= (0b11111111111111111111) << 12;
-            aux |= 0xFFFFFFFFULL << 32;
-        }
-
-        return static_cast<std::int64_t>(aux);
-    }
-
-    template<>
-    std::int64_t BASE_ISA<std::uint64_t>::get_imm_B() const {
-        std::uint64_t aux = 0;
-
-        aux |= this->m_instr[7] << 11;
-        aux |= this->m_instr.range(30, 25) << 5;
-        aux |= this->m_instr[31] << 12;
-        aux |= this->m_instr.range(11, 8) << 1;
-
-        if (this->m_instr[31] == 1) {
-            aux |= (0b11111111111111111111) << 12;
-            aux |= 0xFFFFFFFFULL << 32;
-        }
-
-        return static_cast<std::int64_t>(aux);
-    }
-
-    template<>
-    std::int64_t BASE_ISA<std::uint64_t>::get_imm_J() const {
-        std::uint64_t aux = 0;
-
-        aux = this->m_instr[31] << 20;
-        aux |= this->m_instr.range(19, 12) << 12;
-        aux |= this->m_instr[20] << 11;
-        aux |= this->m_instr.range(30, 21) << 1;
-
-        /* bit extension (better way to do that?) */
-        if (this->m_instr[31] == 1) {
-            aux |= (0b111111111111) << 20;
-        }
-
-        return static_cast<std::int64_t>(aux);
-    }
-
-    template<>
-    std::uint32_t BASE_ISA<std::uint64_t>::get_funct7b() const {
-        return this->m_instr.range(31, 26);
-    }
-
     template<>
     bool BASE_ISA<std::uint64_t>::Exec_SLLI() {
         unsigned int rd, rs1, rs2;
@@ -301,7 +166,7 @@ namespace riscv_tlm {
 
         rd = this->get_rd();
         rs1 = this->get_rs1();
-        rs2 = this->get_shamt_slli();
+        rs2 = this->get_shamt();
 
         if (rs2 >= 0x40) {
             std::cout << "ILLEGAL INSTRUCTION, shamt[5] > 0x40" << "\n";
@@ -316,10 +181,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SLLI: x{:d} << {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLLI: x{:d} << {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -332,17 +197,17 @@ namespace riscv_tlm {
 
         rd = this->get_rd();
         rs1 = this->get_rs1();
-        rs2 = this->get_shamt_slli();
+        rs2 = this->get_shamt();
 
         shift = rs2 & 0x3F;
 
         calc = static_cast<unsigned_T>(this->regs->getValue(rs1)) >> shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRLI: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRLI: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -355,17 +220,17 @@ namespace riscv_tlm {
 
         rd = this->get_rd();
         rs1 = this->get_rs1();
-        rs2 = this->get_shamt_slli();
+        rs2 = this->get_shamt();
 
         shift = rs2 & 0x3F;
 
         calc = static_cast<signed_T>(static_cast<signed_T>(this->regs->getValue(rs1)) >> shift);
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRAI: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRAI: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -385,10 +250,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRL: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRL: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -407,10 +272,10 @@ namespace riscv_tlm {
         calc = static_cast<signed_T>(this->regs->getValue(rs1)) >> shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SRA: x{:d} >> {:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SRA: x{:d} >> {:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
@@ -430,10 +295,10 @@ namespace riscv_tlm {
         calc = this->regs->getValue(rs1) << shift;
         this->regs->setValue(rd, calc);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. SLL: x{:d} << x{:d} -> x{:d}(0x{:x})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, shift, rd, calc);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. SLL: x{:d} << x{:d} -> x{:d}(0x{:x})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, shift, rd, calc);
 
         return true;
     }
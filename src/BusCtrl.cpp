@@ -8,67 +8,100 @@
 
 #include "BusCtrl.h"
 
+#include <sstream>
+
 namespace riscv_tlm {
 
     SC_HAS_PROCESS(BusCtrl);
 
     BusCtrl::BusCtrl(sc_core::sc_module_name const &name) :
             sc_module(name), cpu_instr_socket("cpu_instr_socket"), cpu_data_socket(
-            "cpu_data_socket"), memory_socket("memory_socket"), trace_socket(
-            "trace_socket") {
+            "cpu_data_socket"), target_socket("target_socket"), last_target(nullptr),
+            bound_targets(0) {
         cpu_instr_socket.register_b_transport(this, &BusCtrl::b_transport);
         cpu_data_socket.register_b_transport(this, &BusCtrl::b_transport);
 
         cpu_instr_socket.register_get_direct_mem_ptr(this,
-                                                     &BusCtrl::instr_direct_mem_ptr);
-        memory_socket.register_invalidate_direct_mem_ptr(this,
+                                                     &BusCtrl::direct_mem_ptr);
+        cpu_data_socket.register_get_direct_mem_ptr(this,
+                                                    &BusCtrl::direct_mem_ptr);
+        target_socket.register_invalidate_direct_mem_ptr(this,
                                                          &BusCtrl::invalidate_direct_mem_ptr);
     }
 
+    void BusCtrl::register_target(const std::string &name, tlm::tlm_target_socket<> &socket,
+                                  std::uint64_t base, std::uint64_t size, bool dmi) {
+        bus_target target{name, base, base + size - 1, bound_targets, dmi};
+
+        if (size == 0) {
+            return;
+        }
+
+        for (const auto &other : targets) {
+            if ((target.start <= other.end) && (target.end >= other.start)) {
+                std::stringstream error_msg;
+                error_msg << name << " overlaps " << other.name << " at 0x" << std::hex << base;
+                SC_REPORT_ERROR("BusCtrl", error_msg.str().c_str());
+                return;
+            }
+        }
+
+        target_socket.bind(socket);
+        bound_targets++;
+
+        auto it = std::upper_bound(targets.begin(), targets.end(), target,
+                                   [](const bus_target &a, const bus_target &b) { return a.start < b.start; });
+        targets.insert(it, target);
+        last_target = nullptr;
+    }
+
     void BusCtrl::b_transport(tlm::tlm_generic_payload &trans,
                               sc_core::sc_time &delay) {
+        sc_dt::uint64 adr = trans.get_address();
+        const bus_target *target = find_target(adr);
 
-        sc_dt::uint64 adr = trans.get_address() / 4;
-
-        if (adr >= TO_HOST_ADDRESS / 4) {
-            std::cout << "To host\n" << std::flush;
-            sc_core::sc_stop();
+        if (target == nullptr) [[unlikely]] {
+            if (adr >= TO_HOST_ADDRESS) {
+                std::cout << "To host\n" << std::flush;
+                sc_core::sc_stop();
+                trans.set_response_status(tlm::TLM_OK_RESPONSE);
+                return;
+            }
+            trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
             return;
         }
 
-        switch (adr) {
-            case TIMER_MEMORY_ADDRESS_HI / 4:
-            case TIMER_MEMORY_ADDRESS_LO / 4:
-            case TIMERCMP_MEMORY_ADDRESS_HI / 4:
-            case TIMERCMP_MEMORY_ADDRESS_LO / 4:
-                timer_socket->b_transport(trans, delay);
-                break;
-            case TRACE_MEMORY_ADDRESS / 4:
-                trace_socket->b_transport(trans, delay);
-                break;
-                [[likely]] default:
-                memory_socket->b_transport(trans, delay);
-                break;
+        target_socket[target->socket_id]->b_transport(trans, delay);
+    }
+
+    bool BusCtrl::direct_mem_ptr(tlm::tlm_generic_payload &gp,
+                                 tlm::tlm_dmi &dmi_data) {
+        const bus_target *target = find_target(gp.get_address());
+
+        if ((target == nullptr) || !target->dmi) {
+            return false;
         }
 
-#if 0
-        if (cmd == tlm::TLM_READ_COMMAND) {
-          log->SC_log(Log::DEBUG) << "RD Address: @0x" << hex << adr << dec << endl;
-        } else {
-          log->SC_log(Log::DEBUG) << "WR Address: @0x" << hex << adr << dec << endl;
+        if (!target_socket[target->socket_id]->get_direct_mem_ptr(gp, dmi_data)) {
+            return false;
         }
-#endif
 
-        trans.set_response_status(tlm::TLM_OK_RESPONSE);
-    }
+        /* A device only gets accesses for its own range, other devices must see theirs */
+        if (dmi_data.get_start_address() < target->start) {
+            dmi_data.set_dmi_ptr(dmi_data.get_dmi_ptr() + (target->start - dmi_data.get_start_address()));
+            dmi_data.set_start_address(target->start);
+        }
+        if (dmi_data.get_end_address() > target->end) {
+            dmi_data.set_end_address(target->end);
+        }
 
-    bool BusCtrl::instr_direct_mem_ptr(tlm::tlm_generic_payload &gp,
-                                       tlm::tlm_dmi &dmi_data) {
-        return memory_socket->get_direct_mem_ptr(gp, dmi_data);
+        return true;
     }
 
-    void BusCtrl::invalidate_direct_mem_ptr(sc_dt::uint64 start,
+    void BusCtrl::invalidate_direct_mem_ptr(int id, sc_dt::uint64 start,
                                             sc_dt::uint64 end) {
+        (void) id;
         cpu_instr_socket->invalidate_direct_mem_ptr(start, end);
+        cpu_data_socket->invalidate_direct_mem_ptr(start, end);
     }
-}
\ No newline at end of file
+}
@@ -5,23 +5,31 @@
  \date August 2018
  */
 // SPDX-License-Identifier: GPL-3.0-or-later
+#include <array>
+
 #include "CPU.h"
+#include "FastScheduler.h"
 
 namespace riscv_tlm {
 
     SC_HAS_PROCESS(CPU);
 
     CPU::CPU(sc_core::sc_module_name const &name, bool debug) : sc_module(name), instr_bus("instr_bus"), inst(0), default_time(10, sc_core::SC_NS) {
-        perf = Performance::getInstance();
+        perf = new Performance();
         logger = spdlog::get("my_logger");
 
         m_qk = new tlm_utils::tlm_quantumkeeper();
         m_qk->reset();
-        mem_intf = nullptr;
+        use_qk = false;
+        decode_cache = new DecodeCache();
+        mem_intf = new MemoryInterface();
+        mem_intf->setDecodeCache(decode_cache);
         dmi_ptr_valid = false;
+        exec_mode = INTERPRETER;
+        jit_check = false;
 
-        irq_already_down = false;
         interrupt = false;
+        wfi_request = false;
 
         irq_line_socket.register_b_transport(this, &CPU::call_interrupt);
 
@@ -39,9 +47,19 @@ namespace riscv_tlm {
     };
 
     void CPU::invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end) {
-        (void) start;
-        (void) end;
-        dmi_ptr_valid = false;
+        if ((start <= dmi_end) && (end >= dmi_start)) {
+            dmi_ptr_valid = false;
+        }
+    }
+
+    void CPU::setQuantum(const sc_core::sc_time &quantum) {
+        use_qk = (quantum != sc_core::SC_ZERO_TIME);
+
+        if (use_qk) {
+            tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+            m_qk->reset();
+        }
+        mem_intf->setQuantumKeeper(use_qk ? m_qk : nullptr);
     }
 
     CPU::~CPU() {
@@ -49,29 +67,189 @@ namespace riscv_tlm {
             delete m_qk;
             m_qk = nullptr;
         }
+        if (mem_intf) {
+            delete mem_intf;
+            mem_intf = nullptr;
+        }
+        if (decode_cache) {
+            delete decode_cache;
+            decode_cache = nullptr;
+        }
+        if (decoder) {
+            delete decoder;
+            decoder = nullptr;
+        }
+        if (perf) {
+            delete perf;
+            perf = nullptr;
+        }
+        if (instr_log) {
+            delete instr_log;
+            instr_log = nullptr;
+        }
     }
 
-    [[noreturn]] void CPU::CPU_thread() {
+    bool CPU::open_instr_log(const std::string &filename, unsigned int xlen, trace::codec_t codec) {
+        if constexpr (!InstrLog::enabled) {
+            (void) filename;
+            (void) xlen;
+            (void) codec;
+            return false;
+        } else {
+            delete instr_log;
+            instr_log = nullptr;
+            if (filename.empty()) {
+                mem_intf->setInstrLog(nullptr);
+                return true;
+            }
+            instr_log = new InstrLog(filename, xlen, codec);
+            if (!instr_log->isOpen()) {
+                delete instr_log;
+                instr_log = nullptr;
+            }
+            mem_intf->setInstrLog(instr_log);
+            return instr_log != nullptr;
+        }
+    }
 
-        while (true) {
+    void CPU::count_base(std::uint32_t code, bool PC_not_affected) {
+        perf->fullInstruction();
+
+        switch (static_cast<opCodes>(code)) {
+            case OP_LB:
+            case OP_LH:
+            case OP_LW:
+            case OP_LBU:
+            case OP_LHU:
+            case OP_LWU:
+            case OP_LD:
+                perf->loadInstruction();
+                break;
+            case OP_SB:
+            case OP_SH:
+            case OP_SW:
+            case OP_SD:
+                perf->storeInstruction();
+                break;
+            case OP_BEQ:
+            case OP_BNE:
+            case OP_BLT:
+            case OP_BGE:
+            case OP_BLTU:
+            case OP_BGEU:
+                perf->branchInstruction(!PC_not_affected);
+                break;
+            case OP_CSRRW:
+            case OP_CSRRS:
+            case OP_CSRRC:
+            case OP_CSRRWI:
+            case OP_CSRRSI:
+            case OP_CSRRCI:
+                perf->csrInstruction();
+                break;
+            default:
+                break;
+        }
+    }
 
-            /* Process one instruction */
-            CPU_step();
+    void CPU::count_c(std::uint32_t code, bool PC_not_affected) {
+        perf->compressedInstruction();
+
+        switch (static_cast<op_C_Codes>(code)) {
+            case OP_C_LW:
+            case OP_C_LD:
+            case OP_C_LWSP:
+            case OP_C_LDSP:
+                perf->loadInstruction();
+                break;
+            case OP_C_SW:
+            case OP_C_SD:
+            case OP_C_SWSP:
+            case OP_C_SDSP:
+                perf->storeInstruction();
+                break;
+            case OP_C_BEQZ:
+            case OP_C_BNEZ:
+                perf->branchInstruction(!PC_not_affected);
+                break;
+            default:
+                break;
+        }
+    }
 
-            /* Process IRQ (if any) */
-            cpu_process_IRQ();
+    unsigned int CPU::CPU_execute(bool *irq_taken) {
+        unsigned int executed = 1;
 
-            /* Fixed instruction time to 10 ns (i.e. 100 MHz) */
-//#define USE_QK
-#ifdef USE_QK
-            // Model time used for additional processing
-            m_qk->inc(default_time);
-            if (m_qk->need_sync()) {
+        if (exec_mode == BLOCK) {
+            /* Process a whole basic block */
+            executed = CPU_block();
+        } else {
+            /* Process one instruction, or a fused pair */
+            executed = CPU_fused_step();
+        }
+
+        if (wfi_request) {
+            wfi_request = false;
+            wait_for_interrupt();
+        }
+
+        /* Process IRQ (if any) */
+        *irq_taken = cpu_process_IRQ();
+
+        return executed;
+    }
+
+    unsigned int CPU::irq_cause(std::uint64_t pending) {
+        static constexpr std::array<unsigned int, 6> priority = {11, 3, 7, 9, 1, 5};
+
+        for (auto cause : priority) {
+            if (pending & (static_cast<std::uint64_t>(1) << cause)) {
+                return cause;
+            }
+        }
+
+        /* Any other (platform) interrupt, lowest bit first */
+        return static_cast<unsigned int>(__builtin_ctzll(pending));
+    }
+
+    void CPU::wait_for_interrupt() {
+        auto *scheduler = FastScheduler::getInstance();
+
+        if (scheduler->isEnabled()) {
+            while (!interrupt) {
+                if (!scheduler->run_next()) {
+                    std::cout << "WFI with no pending event, stopping simulation" << std::endl;
+                    sc_core::sc_stop();
+                    return;
+                }
+            }
+        } else {
+            /* Let peripherals catch up first, they may already have an IRQ for us */
+            if (use_qk) {
                 m_qk->sync();
             }
-#else
-            sc_core::wait(default_time);
-#endif
+            if (!interrupt) {
+                sc_core::wait(irq_event);
+            }
+        }
+    }
+
+    [[noreturn]] void CPU::CPU_thread() {
+
+        while (true) {
+            bool irq_taken;
+            unsigned int executed = CPU_execute(&irq_taken);
+
+            /* Fixed instruction time to 10 ns (i.e. 100 MHz) */
+            if (use_qk) {
+                // Model time used for additional processing
+                m_qk->inc(default_time * executed);
+                if (irq_taken || m_qk->need_sync()) {
+                    m_qk->sync();
+                }
+            } else {
+                sc_core::wait(default_time * executed + mem_intf->takeDelay());
+            }
         } // while(1)
     } // CPU_thread
 }
\ No newline at end of file
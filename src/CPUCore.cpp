@@ -0,0 +1,783 @@
+/*!
+ \file CPUCore.cpp
+ \brief RISC-V core templated on XLEN and extension set
+ \author Màrius Montón
+ \date August 2018
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "CPU.h"
+
+namespace riscv_tlm {
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    CPUCore<XLEN, Extensions...>::CPUCore(sc_core::sc_module_name const &name, BaseType PC, bool debug) :
+            CPU(name, debug),
+            register_bank(perf),
+            base_inst(0, &register_bank, mem_intf, perf),
+            c_inst(0, &register_bank, mem_intf, perf),
+            m_inst(0, &register_bank, mem_intf, perf),
+            a_inst(0, &register_bank, mem_intf, perf),
+            INSTR(0) {
+
+        std::uint32_t extensions = (Decoder::extension_bit(BASE_EXTENSION) | ... |
+                                    Decoder::extension_bit(Extensions));
+
+        decoder = new Decoder(XLEN, extensions);
+        block_cache = new BlockCache<CPUCore>(perf);
+        jit = nullptr;
+        register_bank.setISA((has_m ? MISA_M_EXTENSION : 0) | (has_a ? MISA_A_EXTENSION : 0) |
+                             (has_c ? MISA_C_EXTENSION : 0));
+        register_bank.setPC(PC);
+        register_bank.setValue(Registers<BaseType>::sp, (Memory::DEFAULT_SIZE / 4) - 1);
+
+        instr_bus.register_invalidate_direct_mem_ptr(this,
+                                                     &CPU::invalidate_direct_mem_ptr);
+
+        base_inst.setWFIFlag(&wfi_request);
+
+        trans.set_data_ptr(reinterpret_cast<unsigned char *>(&INSTR));
+
+        logger->info("Created {} CPU", isa_name());
+        std::cout << "Created " << isa_name() << " CPU" << std::endl;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    CPUCore<XLEN, Extensions...>::~CPUCore() {
+        if (jit) {
+            delete jit;
+            jit = nullptr;
+        }
+        delete check_initial;
+        delete check_native;
+        if (block_cache) {
+            delete block_cache;
+            block_cache = nullptr;
+        }
+        // m_qk and mem_intf are handled by base class destructor
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    std::string CPUCore<XLEN, Extensions...>::isa_name() {
+        std::string name = "RV" + std::to_string(XLEN) + "I";
+
+        /* Canonical order */
+        if constexpr (has_m) {
+            name += "M";
+        }
+        if constexpr (has_a) {
+            name += "A";
+        }
+        if constexpr (has_c) {
+            name += "C";
+        }
+        return name;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::cpu_process_IRQ() {
+        BaseType pending = register_bank.getIRQPending();
+
+        if (pending == 0) [[likely]] {
+            return false;
+        }
+
+        unsigned int cause = irq_cause(pending);
+
+        LOG_INSTR(logger, "{} ns. PC: 0x{:x}. Interrupt! cause {:d}", sc_core::sc_time_stamp().value(),
+                          register_bank.getPC(), cause);
+
+        /* updated MEPC register */
+        BaseType old_pc = register_bank.getPC();
+        register_bank.setCSR(CSR_MEPC, old_pc);
+
+        LOG_INSTR(logger, "{} ns. PC: 0x{:x}. Old PC Value 0x{:x}", sc_core::sc_time_stamp().value(),
+                          register_bank.getPC(),
+                          old_pc);
+
+        /* update MCAUSE register, interrupt bit is the MSB */
+        register_bank.setCSR(CSR_MCAUSE, (static_cast<BaseType>(1) << (XLEN - 1)) | cause);
+
+        /* Sources are edge triggered, pending bit is consumed by the trap */
+        register_bank.clearIRQ(static_cast<BaseType>(1) << cause);
+
+        /* set new PC address */
+        BaseType new_pc = register_bank.getCSR(CSR_MTVEC);
+        //new_pc = new_pc & 0xFFFFFFFC; // last two bits always to 0
+        LOG_INSTR(logger, "{} ns. PC: 0x{:x}. NEW PC Value 0x{:x}", sc_core::sc_time_stamp().value(),
+                          register_bank.getPC(),
+                          new_pc);
+        register_bank.setPC(new_pc);
+
+        interrupt = false;
+
+        return true;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    decoded_instr *CPUCore<XLEN, Extensions...>::fetch_decode(BaseType pc) {
+        extension_t extension;
+        std::uint32_t code;
+
+        /* Get new PC value, a compressed instruction can end on the last byte of the DMI region */
+        bool fetched = false;
+        if (dmi_ptr_valid && (pc >= dmi_start) && (pc + 1 <= dmi_end)) {
+            std::uint16_t parcel;
+            std::memcpy(&parcel, dmi_ptr + (pc - dmi_start), 2);
+            if ((parcel & 0x3) != 0x3) {
+                INSTR = parcel;
+                fetched = true;
+            } else if (pc + 3 <= dmi_end) {
+                std::memcpy(&INSTR, dmi_ptr + (pc - dmi_start), 4);
+                fetched = true;
+            }
+        }
+
+        if (!fetched) {
+            sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+            tlm::tlm_dmi dmi_data;
+            trans.set_address(pc);
+            instr_bus->b_transport(trans, delay);
+
+            if (trans.is_response_error()) {
+                SC_REPORT_ERROR("CPU base", "Read memory");
+            }
+
+            if (trans.is_dmi_allowed()) {
+                dmi_ptr_valid = instr_bus->get_direct_mem_ptr(trans, dmi_data);
+                if (dmi_ptr_valid) {
+                    logger->debug("DMI for instruction fetch, 0x{:x} to 0x{:x}", dmi_data.get_start_address(),
+                                  dmi_data.get_end_address());
+                    dmi_ptr = dmi_data.get_dmi_ptr();
+                    dmi_start = dmi_data.get_start_address();
+                    dmi_end = dmi_data.get_end_address();
+                }
+            }
+        }
+
+        perf->codeMemoryRead();
+
+        decoder->decode(INSTR, &extension, &code);
+
+        decoded_instr *entry = decode_cache->insert(pc, INSTR, extension, code);
+        if (fusion_enabled) {
+            fuse(entry);
+        }
+        return entry;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    inline decoded_instr *CPUCore<XLEN, Extensions...>::lookup_decode(BaseType pc) {
+        /* Already seen PCs skip fetch & decode */
+        decoded_instr *entry = decode_cache->lookup(pc);
+        if (entry != nullptr) {
+            perf->decodeCacheHit();
+        } else {
+            perf->decodeCacheMiss();
+            entry = fetch_decode(pc);
+        }
+        return entry;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    void CPUCore<XLEN, Extensions...>::fuse(decoded_instr *entry) {
+        /*
+         * Either instruction of a pair may be decoded last, or decoded again
+         * after a write to code, so check both neighbours. The previous
+         * instruction is 4 or 2 bytes long.
+         */
+        for (unsigned int length : {4U, 2U}) {
+            decoded_instr *previous = decode_cache->lookup(entry->pc - length);
+            if ((previous != nullptr) && (Fusion::length(*previous) == length)) {
+                previous->fusion = Fusion::pair(*previous, *entry);
+            }
+        }
+
+        decoded_instr *next = decode_cache->lookup(entry->pc + Fusion::length(*entry));
+        if (next != nullptr) {
+            entry->fusion = Fusion::pair(*entry, *next);
+        }
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    template<extension_t extension>
+    bool CPUCore<XLEN, Extensions...>::exec(const decoded_instr &entry, bool *breakpoint) {
+        bool PC_not_affected;
+
+        inst.setInstr(entry.instr);
+        if constexpr (extension == BASE_EXTENSION) {
+            PC_not_affected = base_inst.exec_instruction(inst, breakpoint, static_cast<opCodes>(entry.code));
+            if (PC_not_affected) {
+                register_bank.incPC();
+            }
+            if constexpr (Performance::enabled) {
+                count_base(entry.code, PC_not_affected);
+            }
+        } else if constexpr (extension == C_EXTENSION) {
+            PC_not_affected = c_inst.exec_instruction(inst, breakpoint, static_cast<op_C_Codes>(entry.code));
+            if (PC_not_affected) {
+                register_bank.incPCby2();
+            }
+            if constexpr (Performance::enabled) {
+                count_c(entry.code, PC_not_affected);
+            }
+        } else if constexpr (extension == M_EXTENSION) {
+            (void) breakpoint;
+            PC_not_affected = m_inst.exec_instruction(inst, static_cast<op_M_Codes>(entry.code));
+            if (PC_not_affected) {
+                register_bank.incPC();
+            }
+            perf->fullInstruction();
+        } else {
+            static_assert(extension == A_EXTENSION, "extension has no handler");
+            (void) breakpoint;
+            PC_not_affected = a_inst.exec_instruction(inst, static_cast<op_A_Codes>(entry.code));
+            if (PC_not_affected) {
+                register_bank.incPC();
+            }
+            perf->fullInstruction();
+            perf->amoInstruction();
+        }
+        return PC_not_affected;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::exec_unknown(const decoded_instr &entry, bool *breakpoint) {
+        (void) breakpoint;
+        inst.setInstr(entry.instr);
+        std::cout << "Extension not implemented yet" << std::endl;
+        inst.dump();
+        base_inst.NOP();
+        return false;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    inline bool CPUCore<XLEN, Extensions...>::execute(const decoded_instr &entry, bool *breakpoint) {
+        /* Extensions left out never come from the decoder, no case for them */
+        switch (entry.extension) {
+            [[likely]] case BASE_EXTENSION:
+                return exec<BASE_EXTENSION>(entry, breakpoint);
+            case C_EXTENSION:
+                if constexpr (has_c) {
+                    return exec<C_EXTENSION>(entry, breakpoint);
+                }
+                break;
+            case M_EXTENSION:
+                if constexpr (has_m) {
+                    return exec<M_EXTENSION>(entry, breakpoint);
+                }
+                break;
+            case A_EXTENSION:
+                if constexpr (has_a) {
+                    return exec<A_EXTENSION>(entry, breakpoint);
+                }
+                break;
+            default:
+                break;
+        }
+        return exec_unknown(entry, breakpoint);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    typename CPUCore<XLEN, Extensions...>::handler_t
+    CPUCore<XLEN, Extensions...>::handler_for(extension_t extension) {
+        switch (extension) {
+            case BASE_EXTENSION:
+                return &CPUCore::exec<BASE_EXTENSION>;
+            case C_EXTENSION:
+                if constexpr (has_c) {
+                    return &CPUCore::exec<C_EXTENSION>;
+                }
+                break;
+            case M_EXTENSION:
+                if constexpr (has_m) {
+                    return &CPUCore::exec<M_EXTENSION>;
+                }
+                break;
+            case A_EXTENSION:
+                if constexpr (has_a) {
+                    return &CPUCore::exec<A_EXTENSION>;
+                }
+                break;
+            default:
+                break;
+        }
+        return &CPUCore::exec_unknown;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    inline bool CPUCore<XLEN, Extensions...>::step(const decoded_instr &entry) {
+        bool breakpoint = false;
+
+        execute(entry, &breakpoint);
+        trace_instr(entry);
+
+        if (breakpoint) {
+            std::cout << "Breakpoint set to true\n";
+        }
+
+        perf->instructionsInc();
+        register_bank.retire(1);
+
+        return breakpoint;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::CPU_step() {
+        return step(*lookup_decode(register_bank.getPC()));
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    unsigned int CPUCore<XLEN, Extensions...>::CPU_fused_step() {
+        const decoded_instr *head = lookup_decode(register_bank.getPC());
+
+        /* Commit trace records the writes of each instruction, pairs run unfused while it is on */
+        if ((head->fusion == FUSE_NONE) || (instr_log != nullptr)) [[likely]] {
+            step(*head);
+            return 1;
+        }
+
+        /* Second instruction was written or replaced since the pair was found */
+        const decoded_instr *next = decode_cache->lookup(head->pc + Fusion::length(*head));
+        if ((next == nullptr) || !exec_fused(*head, *next)) {
+            step(*head);
+            return 1;
+        }
+
+        perf->decodeCacheHit();
+        perf->fusedPair();
+        perf->instructionsInc(2);
+        register_bank.retire(2);
+        return 2;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::exec_fused(const decoded_instr &head, const decoded_instr &next) {
+        using SignedType = std::make_signed_t<BaseType>;
+
+        const bool head_c = (head.extension == C_EXTENSION);
+        const bool next_c = (next.extension == C_EXTENSION);
+        BaseType new_pc = head.pc + Fusion::length(head) + Fusion::length(next);
+        bool next_pc_not_affected = true;
+
+        switch (static_cast<fusion_t>(head.fusion)) {
+            case FUSE_LUI_ADDI: {
+                std::uint32_t rd = head_c ? fields::c_rs1(head.instr) : fields::rd(head.instr);
+                BaseType value = static_cast<BaseType>(head_c ? fields::c_imm_LUI(head.instr)
+                                                              : static_cast<std::int32_t>(fields::imm_U(head.instr) << 12));
+                std::int32_t imm = next_c ? fields::c_imm_ADDI(next.instr) : fields::imm_I(next.instr);
+                bool word = next_c ? (next.code == OP_C_ADDIW) : (next.code == OP_ADDIW);
+
+                value = value + imm;
+                if (word) {
+                    value = static_cast<BaseType>(static_cast<std::int32_t>(value & 0xFFFFFFFF));
+                }
+                register_bank.setValue(rd, value);
+                break;
+            }
+            case FUSE_AUIPC_JALR:
+            case FUSE_AUIPC_LOAD: {
+                std::uint32_t rd = fields::rd(head.instr);
+                std::uint32_t next_rd = fields::rd(next.instr);
+                BaseType base = head.pc + static_cast<std::int32_t>(fields::imm_U(head.instr) << 12);
+                BaseType address = base + fields::imm_I(next.instr);
+                BaseType value;
+
+                if (head.fusion == FUSE_AUIPC_JALR) {
+                    value = head.pc + 4 + 4;
+                    new_pc = address & ~static_cast<BaseType>(1);
+                    next_pc_not_affected = false;
+                } else {
+                    if (next.code == OP_LW) {
+                        value = static_cast<std::int32_t>(mem_intf->readDataMem(address, 4));
+                    } else if (next.code == OP_LWU) {
+                        value = static_cast<std::uint32_t>(mem_intf->readDataMem(address, 4));
+                    } else {
+                        value = mem_intf->readDataMem(address, 8);
+                    }
+                    perf->dataMemoryRead();
+                }
+
+                /* auipc result is only visible if the second instruction writes elsewhere */
+                if (rd != next_rd) {
+                    register_bank.setValue(rd, base);
+                }
+                register_bank.setValue(next_rd, value);
+                break;
+            }
+            case FUSE_SLLI_SRLI: {
+                std::uint32_t rd = head_c ? fields::c_rs1(head.instr) : fields::rd(head.instr);
+                std::uint32_t rs1 = head_c ? rd : fields::rs1(head.instr);
+                std::uint32_t left = head_c ? fields::c_shamt(head.instr) : fields::shamt(head.instr);
+                std::uint32_t right = next_c ? fields::c_shamt(next.instr) : fields::shamt(next.instr);
+
+                /* Reserved shift amounts (>= 32 on RV32) keep the behaviour of each handler */
+                if ((left >= XLEN) || (right >= XLEN)) {
+                    return false;
+                }
+                register_bank.setValue(rd, (register_bank.getValue(rs1) << left) >> right);
+                break;
+            }
+            case FUSE_CMP_BRANCH: {
+                std::uint32_t rd = fields::rd(head.instr);
+                BaseType val1 = register_bank.getValue(fields::rs1(head.instr));
+                bool less;
+
+                switch (static_cast<opCodes>(head.code)) {
+                    case OP_SLT:
+                        less = static_cast<SignedType>(val1) <
+                               static_cast<SignedType>(register_bank.getValue(fields::rs2(head.instr)));
+                        break;
+                    case OP_SLTU:
+                        less = val1 < register_bank.getValue(fields::rs2(head.instr));
+                        break;
+                    case OP_SLTI:
+                        less = static_cast<SignedType>(val1) < fields::imm_I(head.instr);
+                        break;
+                    default:
+                        less = val1 < static_cast<BaseType>(static_cast<SignedType>(fields::imm_I(head.instr)));
+                        break;
+                }
+                register_bank.setValue(rd, less ? 1 : 0);
+
+                /* Branch compares rd with zero */
+                bool taken;
+                std::int32_t offset;
+                if (next_c) {
+                    taken = (next.code == OP_C_BNEZ) == less;
+                    offset = fields::c_imm_CB(next.instr);
+                } else {
+                    taken = (next.code == OP_BNE) == less;
+                    offset = fields::imm_B(next.instr);
+                }
+                if (taken) {
+                    new_pc = next.pc + offset;
+                }
+                next_pc_not_affected = false;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        register_bank.setPC(new_pc);
+
+        if constexpr (Performance::enabled) {
+            if (head_c) {
+                count_c(head.code, true);
+            } else {
+                count_base(head.code, true);
+            }
+            if (next_c) {
+                count_c(next.code, next_pc_not_affected);
+            } else {
+                count_base(next.code, next_pc_not_affected);
+            }
+        }
+
+        return true;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    typename CPUCore<XLEN, Extensions...>::block_t *
+    CPUCore<XLEN, Extensions...>::translate_block(BaseType pc) {
+        block_t *block = block_cache->create(pc);
+
+        while (block->ops.size() < BlockCache<CPUCore>::MAX_BLOCK_LENGTH) {
+            decoded_instr *entry = decode_cache->lookup(pc);
+            if (entry == nullptr) {
+                entry = fetch_decode(pc);
+            }
+
+            unsigned int length = (entry->extension == C_EXTENSION) ? 2 : 4;
+            block->ops.push_back({handler_for(entry->extension), *entry, length,
+                                  static_cast<unsigned int>(block->ops.size())});
+
+            if (BlockCache<CPUCore>::ends_block(*entry)) {
+                break;
+            }
+            pc += length;
+        }
+
+        block_cache->finish(block);
+        perf->blockTranslated();
+        return block;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    unsigned int CPUCore<XLEN, Extensions...>::run_block(const block_t *block) {
+        bool breakpoint = false;
+        unsigned int executed = 0;
+        std::uint64_t generation = decode_cache->getGeneration();
+
+        for (const auto &op : block->ops) {
+            /* An exception or a write to code leaves the rest of the block stale */
+            if ((register_bank.getPC() != op.instr.pc) ||
+                (decode_cache->getGeneration() != generation)) {
+                break;
+            }
+
+            (this->*op.handler)(op.instr, &breakpoint);
+            trace_instr(op.instr);
+            perf->instructionsInc();
+            register_bank.retire(1);
+            executed++;
+
+            if (breakpoint) {
+                std::cout << "Breakpoint set to true\n";
+                breakpoint = false;
+                block_breakpoint = true;
+            }
+        }
+
+        return executed;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    unsigned int CPUCore<XLEN, Extensions...>::exec_block() {
+        BaseType pc = register_bank.getPC();
+
+        /* Code written since last block? then all blocks and links are stale */
+        if (block_cache->sync(decode_cache->getGeneration()) && (jit != nullptr)) {
+            jit->flush();
+        }
+
+        block_t *block = block_cache->follow(pc);
+        if (block == nullptr) {
+            block = translate_block(pc);
+        }
+        block_cache->enter(block);
+
+        perf->blockExecuted();
+
+        /* Commit trace records every instruction and its writes, native code would skip
+         * them: blocks run interpreted while it is on */
+        if ((jit != nullptr) && (instr_log == nullptr)) {
+            if ((block->native == nullptr) && (++block->executions == JIT<BaseType>::HOT_THRESHOLD)) {
+                jit_compile(block);
+            }
+            if (block->native != nullptr) {
+                return jit_run(block);
+            }
+        }
+
+        return run_block(block);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    unsigned int CPUCore<XLEN, Extensions...>::CPU_block() {
+        unsigned int executed = 0;
+
+        /* Chained blocks run back to back, stop at MAX_BLOCK_LENGTH instructions to keep
+         * the IRQ latency of a single block, or as soon as an IRQ or WFI needs CPU_execute.
+         * ECALL/EBREAK stop too, sc_stop() only takes effect at the next wait() */
+        block_breakpoint = false;
+        do {
+            executed += exec_block();
+        } while ((executed < BlockCache<CPUCore>::MAX_BLOCK_LENGTH) && !wfi_request && !block_breakpoint &&
+                 (register_bank.getIRQPending() == 0));
+
+        return executed;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    void CPUCore<XLEN, Extensions...>::enableJIT(bool check) {
+        if (jit == nullptr) {
+            /* Translator only reads C fields of C instructions, none without C */
+            C_extension<BaseType> *c_ext = nullptr;
+            if constexpr (has_c) {
+                c_ext = &c_inst;
+            }
+            jit = new JIT<BaseType>(&register_bank, &base_inst, c_ext, &CPUCore::jit_helper);
+        }
+        if (check && (check_initial == nullptr)) {
+            check_initial = new Registers<BaseType>(register_bank);
+            check_native = new Registers<BaseType>(register_bank);
+        }
+        jit_check = check;
+        exec_mode = BLOCK;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::setInstrLog(const std::string &filename, trace::codec_t codec) {
+        bool opened = open_instr_log(filename, XLEN, codec);
+        register_bank.setInstrLog(instr_log);
+        return opened;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    void CPUCore<XLEN, Extensions...>::jit_compile(block_t *block) {
+        std::vector<typename JIT<BaseType>::jit_op> ops;
+        bool replayable = true;
+        bool writes_csrs = false;
+
+        ops.reserve(block->ops.size());
+        for (const auto &op : block->ops) {
+            ops.push_back({&op.instr, op.length, &op});
+            replayable = replayable && jit->is_replayable(op.instr);
+            writes_csrs = writes_csrs || jit->may_write_csrs(op.instr);
+        }
+
+        auto native = jit->compile(ops);
+        if (native != nullptr) {
+            block->native = reinterpret_cast<void (*)()>(native);
+            block->replayable = replayable;
+            block->writes_csrs = writes_csrs;
+            perf->jitBlockCompiled();
+        }
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    unsigned int CPUCore<XLEN, Extensions...>::jit_run(const block_t *block) {
+        auto native = reinterpret_cast<typename JIT<BaseType>::native_block>(block->native);
+        BaseType *regs = register_bank.getRawRegisters();
+
+        perf->jitBlockExecuted();
+
+        jit_retired = 0;
+        if (!jit_check || !block->replayable) {
+            unsigned int executed = native(regs, this);
+            perf->instructionsInc(executed);
+            register_bank.retire(executed - jit_retired);
+            return executed;
+        }
+
+        /* Differential test: run natively recording data accesses, then again in the interpreter
+         * from the same registers and CSRs, replaying them so devices see each access once */
+        const BaseType *native_regs = check_native->getRawRegisters();
+        std::uint64_t generation = decode_cache->getGeneration();
+        BaseType mip = register_bank.getCSR(CSR_MIP);
+
+        /* 4096 CSRs are only saved and compared if the block may write some */
+        check_initial->copyState(register_bank, block->writes_csrs);
+        mem_intf->setReplay(MemoryInterface::REPLAY_RECORD);
+        unsigned int native_executed = native(regs, this);
+        mem_intf->setReplay(MemoryInterface::REPLAY_OFF);
+        register_bank.retire(native_executed - jit_retired);
+
+        /* Stores are not done again, the interpreter would not see this write to code
+         * nor the IRQ a device raised */
+        if ((decode_cache->getGeneration() != generation) || (register_bank.getCSR(CSR_MIP) != mip)) {
+            perf->instructionsInc(native_executed);
+            return native_executed;
+        }
+
+        check_native->copyState(register_bank, block->writes_csrs);
+        BaseType native_pc = register_bank.getPC();
+
+        register_bank.copyState(*check_initial, block->writes_csrs);
+        mem_intf->setReplay(MemoryInterface::REPLAY_CHECK);
+        unsigned int executed = run_block(block);
+        bool accesses_match = mem_intf->replayMatches();
+        mem_intf->setReplay(MemoryInterface::REPLAY_OFF);
+
+        bool mismatch = (executed != native_executed) || (register_bank.getPC() != native_pc);
+        for (unsigned int i = 0; i < 32; i++) {
+            if (regs[i] != native_regs[i]) {
+                std::cerr << "JIT check: x" << std::dec << i << " native 0x" << std::hex << native_regs[i]
+                          << " interpreter 0x" << regs[i] << std::dec << std::endl;
+                mismatch = true;
+            }
+        }
+
+        if (!accesses_match) {
+            std::cerr << "JIT check: data accesses differ" << std::endl;
+            mismatch = true;
+        }
+
+        /* Same registers and PC, anything else is CSRs or counters */
+        if (!mismatch && !register_bank.sameState(*check_native, block->writes_csrs)) {
+            std::cerr << "JIT check: CSRs or counters differ" << std::endl;
+            mismatch = true;
+        }
+
+        if (mismatch) {
+            std::cerr << "JIT check failed at block 0x" << std::hex << block->pc
+                      << ": native PC 0x" << native_pc << " (" << std::dec << native_executed
+                      << " instr), interpreter PC 0x" << std::hex << register_bank.getPC()
+                      << " (" << std::dec << executed << " instr)" << std::endl;
+            SC_REPORT_ERROR("CPU base", "JIT check failed");
+        }
+
+        return executed;
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::jit_helper(void *cpu, const void *arg) {
+        auto *self = static_cast<CPUCore *>(cpu);
+        auto *op = static_cast<const typename BlockCache<CPUCore>::block_op *>(arg);
+        bool breakpoint = false;
+        std::uint64_t generation = self->decode_cache->getGeneration();
+
+        /* Counter CSRs read the same value as in the interpreter, which retires one by one */
+        self->register_bank.retire(op->index - self->jit_retired);
+        self->jit_retired = op->index;
+
+        (self->*op->handler)(op->instr, &breakpoint);
+
+        if (breakpoint) {
+            std::cout << "Breakpoint set to true\n";
+            self->block_breakpoint = true;
+        }
+
+        /* Same checks the block interpreter does before the next instruction */
+        return (self->register_bank.getPC() == op->instr.pc + op->length) &&
+               (self->decode_cache->getGeneration() == generation);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    void CPUCore<XLEN, Extensions...>::call_interrupt(tlm::tlm_generic_payload &m_trans,
+                                                      sc_core::sc_time &delay) {
+        std::uint32_t cause;
+
+        /* Socket caller send a cause (its id), interrupt bit set */
+        memcpy(&cause, m_trans.get_data_ptr(), sizeof(cause));
+        delay = sc_core::SC_ZERO_TIME;
+
+        /* MIP has one bit per cause, higher ones do not exist in this XLEN */
+        cause &= IRQ_CAUSE_MASK;
+        if (cause >= XLEN) {
+            SC_REPORT_WARNING("CPU", "Interrupt cause out of MIP range, ignored");
+            return;
+        }
+
+        register_bank.raiseIRQ(static_cast<BaseType>(1) << cause);
+        interrupt = true;
+        irq_event.notify(sc_core::SC_ZERO_TIME);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    std::uint64_t CPUCore<XLEN, Extensions...>::getStartDumpAddress() {
+        return register_bank.getValue(Registers<BaseType>::t0);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    std::uint64_t CPUCore<XLEN, Extensions...>::getEndDumpAddress() {
+        return register_bank.getValue(Registers<BaseType>::t1);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    void CPUCore<XLEN, Extensions...>::saveState(std::ostream &out) {
+        Checkpoint::put<std::uint32_t>(out, XLEN);
+        register_bank.save(out);
+        Checkpoint::put<std::uint8_t>(out, interrupt);
+    }
+
+    template<unsigned int XLEN, extension_t... Extensions>
+    bool CPUCore<XLEN, Extensions...>::restoreState(std::istream &in) {
+        if (Checkpoint::get<std::uint32_t>(in) != XLEN) {
+            return false;
+        }
+
+        register_bank.restore(in);
+        interrupt = Checkpoint::get<std::uint8_t>(in) != 0;
+
+        /* Memory contents are replaced */
+        decode_cache->flush();
+
+        return in.good();
+    }
+
+    template class CPUCore<32>;
+    template class CPUCore<32, M_EXTENSION, A_EXTENSION, C_EXTENSION>;
+    template class CPUCore<64, M_EXTENSION, A_EXTENSION, C_EXTENSION>;
+}
@@ -0,0 +1,80 @@
+/*!
+ \file Checkpoint.cpp
+ \brief Save and restore full system state
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Checkpoint.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "CPU.h"
+#include "FastScheduler.h"
+#include "Memory.h"
+#include "Timer.h"
+
+namespace riscv_tlm {
+
+    namespace {
+        const char MAGIC[8] = {'R', 'V', 'T', 'L', 'M', 'C', 'K', 'P'};
+    }
+
+    bool Checkpoint::save(const std::string &filename, CPU *cpu, Memory *memory, peripherals::Timer *timer) {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+
+        if (!out.is_open()) {
+            std::cerr << "Checkpoint: cannot create " << filename << std::endl;
+            return false;
+        }
+
+        out.write(MAGIC, sizeof(MAGIC));
+        put<std::uint32_t>(out, VERSION);
+        put<std::uint64_t>(out, FastScheduler::time_stamp());
+
+        cpu->saveState(out);
+        timer->saveState(out);
+        memory->saveState(out);
+
+        if (!out.good()) {
+            std::cerr << "Checkpoint: error writing " << filename << std::endl;
+            return false;
+        }
+
+        std::cout << "Checkpoint saved to " << filename << " at "
+                  << sc_core::sc_time::from_value(FastScheduler::time_stamp()) << std::endl;
+        return true;
+    }
+
+    bool Checkpoint::restore(const std::string &filename, CPU *cpu, Memory *memory, peripherals::Timer *timer) {
+        std::ifstream in(filename, std::ios::binary);
+        char magic[sizeof(MAGIC)];
+
+        if (!in.is_open()) {
+            std::cerr << "Checkpoint: cannot open " << filename << std::endl;
+            return false;
+        }
+
+        in.read(magic, sizeof(magic));
+        if (!in.good() || (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) ||
+            (get<std::uint32_t>(in) != VERSION)) {
+            std::cerr << "Checkpoint: " << filename << " is not a valid checkpoint" << std::endl;
+            return false;
+        }
+
+        auto saved_time = get<std::uint64_t>(in);
+
+        /* Same order as save() */
+        if (!cpu->restoreState(in) || !timer->restoreState(in) || !memory->restoreState(in, filename)) {
+            std::cerr << "Checkpoint: " << filename << " does not match this system" << std::endl;
+            return false;
+        }
+
+        std::cout << "Checkpoint restored from " << filename << ", taken at "
+                  << sc_core::sc_time::from_value(saved_time) << std::endl;
+        return true;
+    }
+}
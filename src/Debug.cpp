@@ -12,6 +12,7 @@
 #include <cstring>
 #include <sstream>
 #include <iomanip>
+#include <vector>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <boost/algorithm/string.hpp>
@@ -23,41 +24,8 @@ namespace riscv_tlm {
     constexpr char nibble_to_hex[16] = {'0', '1', '2', '3', '4', '5', '6', '7',
                                         '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 
-    Debug::Debug(riscv_tlm::CPURV32 *cpu, Memory *mem) : sc_module(sc_core::sc_module_name("Debug")) {
-        dbg_cpu32 = cpu;
-        dbg_cpu64 = nullptr;
-        register_bank32 = nullptr;
-        register_bank64 = nullptr;
-        dbg_mem = mem;
-        cpu_type = riscv_tlm::RV32;
-
-        int sock = socket(AF_INET, SOCK_STREAM, 0);
-
-        int optval = 1;
-        setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &optval,
-                   sizeof(optval));
-
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = INADDR_ANY;
-        addr.sin_port = htons(1234);
-
-        bind(sock, (struct sockaddr *) &addr, sizeof(addr));
-        listen(sock, 1);
-
-        socklen_t len = sizeof(addr);
-        conn = accept(sock, (struct sockaddr *) &addr, &len);
-
-        handle_gdb_loop();
-    }
-
-    Debug::Debug(riscv_tlm::CPURV64 *cpu, Memory *mem) : sc_module(sc_core::sc_module_name("Debug")) {
-        dbg_cpu32 = nullptr;
-        dbg_cpu64 = cpu;
-        register_bank32 = nullptr;
-        register_bank64 = nullptr;
-        dbg_mem = mem;
-        cpu_type = riscv_tlm::RV64;
+    Debug::Debug(riscv_tlm::CPU *cpu) : sc_module(sc_core::sc_module_name("Debug")) {
+        dbg_cpu = cpu;
 
         int sock = socket(AF_INET, SOCK_STREAM, 0);
 
@@ -109,11 +77,8 @@ namespace riscv_tlm {
     void Debug::handle_gdb_loop() {
         std::cout << "Handle_GDB_Loop\n";
 
-        if (dbg_cpu32 != nullptr) {
-            register_bank32 = dbg_cpu32->getRegisterBank();
-        } else {
-            register_bank64 = dbg_cpu64->getRegisterBank();
-        }
+        /* Hex digits of a register */
+        int reg_width = static_cast<int>(dbg_cpu->getXLEN() / 4);
 
         while (true) {
             std::string msg = receive_packet();
@@ -151,75 +116,72 @@ namespace riscv_tlm {
                 std::stringstream stream;
                 stream << std::setfill('0') << std::hex;
                 for (int i = 1; i < 32; i++) {
-                    if (cpu_type == riscv_tlm::RV32) {
-                        stream << std::setw(8) << register_bank32->getValue(i);
-                    }
+                    stream << std::setw(reg_width) << dbg_cpu->getRegister(i);
                 }
                 send_packet(conn, stream.str());
             } else if (boost::starts_with(msg, "p")) {
                 long n = strtol(msg.c_str() + 1, nullptr, 16);
                 std::uint64_t reg_value = 0;
                 if (n < 32) {
-                    if (cpu_type == riscv_tlm::RV32) {
-                        reg_value = register_bank32->getValue(n);
-                    } else {
-                        reg_value = register_bank64->getValue(n);
-                    }
+                    reg_value = dbg_cpu->getRegister(n);
                 } else if (n == 32) {
-                    if (cpu_type == riscv_tlm::RV32) {
-                        reg_value = register_bank32->getPC();
-                    } else {
-                        reg_value = register_bank64->getPC();
-                    }
+                    reg_value = dbg_cpu->getPC();
+                } else if ((n < 65) || (n - 65 >= 4096)) {
+                    /* No FP registers */
+                    reg_value = 0;
                 } else {
                     // see: https://github.com/riscv/riscv-gnu-toolchain/issues/217
                     // risc-v register 834
-                    if (cpu_type == riscv_tlm::RV32) {
-                        reg_value = register_bank32->getCSR(n - 65);
-                    } else {
-                        reg_value = register_bank64->getCSR(n - 65);
-                    }
+                    reg_value = dbg_cpu->getCSR(n - 65);
                 }
                 std::stringstream stream;
                 stream << std::setfill('0') << std::hex;
-                if (cpu_type == riscv_tlm::RV32) {
-                    stream << std::setw(8) << htonl(reg_value);
-                } else {
-                    stream << std::setw(16) << htonl(reg_value);
-                }
+                stream << std::setw(reg_width) << htonl(reg_value);
                 send_packet(conn, stream.str());
             } else if (boost::starts_with(msg, "P")) {
                 char *pEnd;
                 long reg = strtol(msg.c_str() + 1, &pEnd, 16);
                 int val = strtol(pEnd + 1, nullptr, 16);
-                if (cpu_type == riscv_tlm::RV32) {
-                    register_bank32->setValue(reg + 1, val);
-                } else {
-                    register_bank64->setValue(reg + 1, val);
-                }
+                dbg_cpu->setRegister(reg + 1, val);
                 send_packet(conn, "OK");
             } else if (boost::starts_with(msg, "m")) {
                 char *pEnd;
-                long addr = strtol(msg.c_str() + 1, &pEnd, 16);
-                int len = strtol(pEnd + 1, &pEnd, 16);
-
-                dbg_trans.set_data_ptr(pyld_array);
-                dbg_trans.set_command(tlm::TLM_READ_COMMAND);
-                dbg_trans.set_address(addr);
-                dbg_trans.set_data_length(len);
-                dbg_mem->transport_dbg(dbg_trans);
+                std::uint64_t addr = strtoull(msg.c_str() + 1, &pEnd, 16);
+                unsigned int len = strtoul(pEnd + 1, &pEnd, 16);
+                std::vector<unsigned char> data(len);
+
+                /* Debugger may ask for any address, a bus error is an error reply */
+                if (!dbg_cpu->mem_intf->readDataBurst(addr, data.data(), len)) {
+                    send_packet(conn, "E01");
+                    continue;
+                }
 
                 std::stringstream stream;
                 stream << std::setfill('0') << std::hex;
-                for (auto &c: pyld_array) {
+                for (auto c: data) {
                     stream << std::setw(2) << (0xFF & c);
                 }
 
                 send_packet(conn, stream.str());
 
             } else if (boost::starts_with(msg, "M")) {
-                printf("M TBD\n");
-                send_packet(conn, "OK");
+                char *pEnd;
+                std::uint64_t addr = strtoull(msg.c_str() + 1, &pEnd, 16);
+                unsigned int len = strtoul(pEnd + 1, &pEnd, 16);
+                std::vector<unsigned char> data(len);
+
+                /* Data follows ':' as two hex digits per byte */
+                for (unsigned int i = 0; (i < len) && (*pEnd != '\0') && (pEnd[1] != '\0'); i++) {
+                    char byte[3] = {pEnd[1], pEnd[2], '\0'};
+                    data[i] = static_cast<unsigned char>(strtoul(byte, nullptr, 16));
+                    pEnd += 2;
+                }
+
+                if (dbg_cpu->mem_intf->writeDataBurst(addr, data.data(), len)) {
+                    send_packet(conn, "OK");
+                } else {
+                    send_packet(conn, "E01");
+                }
             } else if (boost::starts_with(msg, "X")) {
                 send_packet(conn, "");  // binary data unsupported
             } else if (msg == "qOffsets") {
@@ -232,15 +194,8 @@ namespace riscv_tlm {
                 bool breakpoint_hit = false;
                 bool bkpt = false;
                 do {
-                    std::uint64_t currentPC;
-
-                    if (cpu_type == riscv_tlm::RV32) {
-                        bkpt = dbg_cpu32->CPU_step();
-                        currentPC = register_bank32->getPC();
-                    } else {
-                        bkpt = dbg_cpu64->CPU_step();
-                        currentPC = register_bank64->getPC();
-                    }
+                    bkpt = dbg_cpu->CPU_step();
+                    std::uint64_t currentPC = dbg_cpu->getPC();
 
                     auto search = breakpoints.find(currentPC);
                     if (search != breakpoints.end()) {
@@ -253,18 +208,9 @@ namespace riscv_tlm {
             } else if (msg == "s") {
 
                 bool breakpoint;
-                if (cpu_type == riscv_tlm::RV32) {
-                    dbg_cpu32->CPU_step();
-                } else {
-                    dbg_cpu64->CPU_step();
-                }
+                dbg_cpu->CPU_step();
 
-                std::uint64_t currentPC;
-                if (cpu_type == riscv_tlm::RV32) {
-                    currentPC = register_bank32->getPC();
-                } else {
-                    currentPC = register_bank64->getPC();
-                }
+                std::uint64_t currentPC = dbg_cpu->getPC();
 
                 auto search = breakpoints.find(currentPC);
                 if (search != breakpoints.end()) {
@@ -0,0 +1,77 @@
+/*!
+ \file DecodeCache.cpp
+ \brief Predecoded instruction cache
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DecodeCache.h"
+
+namespace riscv_tlm {
+
+    DecodeCache::DecodeCache() {
+        flush();
+    }
+
+    decoded_instr *DecodeCache::insert(std::uint64_t pc, std::uint32_t instr,
+                                       extension_t extension, std::uint32_t code) {
+        decoded_instr &entry = cache[index(pc)];
+
+        entry.pc = pc;
+        entry.instr = instr;
+        entry.extension = extension;
+        entry.code = code;
+        entry.fusion = 0;
+        entry.valid = true;
+
+        /* Instructions are 4 bytes long at most */
+        if (pc < code_start) {
+            code_start = pc;
+        }
+        if (pc + 4 > code_end) {
+            code_end = pc + 4;
+        }
+        code_lines.insert(pc >> LINE_SHIFT);
+        code_lines.insert((pc + 3) >> LINE_SHIFT);
+
+        return &entry;
+    }
+
+    void DecodeCache::invalidate_range(std::uint64_t addr, unsigned int len) {
+        /* Data in between code: nothing decoded there, nothing stale */
+        bool code_written = false;
+        for (std::uint64_t line = addr >> LINE_SHIFT; line <= (addr + len - 1) >> LINE_SHIFT; line++) {
+            if (code_lines.count(line) != 0) {
+                code_written = true;
+                break;
+            }
+        }
+        if (!code_written) {
+            return;
+        }
+
+        /* Any instruction starting up to 3 bytes before addr overlaps the written bytes */
+        std::uint64_t pc = (addr < 3) ? 0 : addr - 3;
+        pc = (pc + 1) & ~static_cast<std::uint64_t>(1);
+
+        generation++;
+
+        for (; pc < addr + len; pc += 2) {
+            decoded_instr &entry = cache[index(pc)];
+            if (entry.valid && (entry.pc == pc)) {
+                entry.valid = false;
+            }
+        }
+    }
+
+    void DecodeCache::flush() {
+        for (auto &entry : cache) {
+            entry.valid = false;
+        }
+        code_start = UINT64_MAX;
+        code_end = 0;
+        code_lines.clear();
+        generation++;
+    }
+}
@@ -0,0 +1,250 @@
+/*!
+ \file Decoder.cpp
+ \brief Table driven decoder of all supported extensions
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Decoder.h"
+
+#include <utility>
+
+#include "BASE_ISA.h"
+#include "C_extension.h"
+#include "M_extension.h"
+#include "A_extension.h"
+
+namespace riscv_tlm {
+
+    namespace {
+        enum {
+            AMO = 0b0101111,
+            M_F7 = 0b0000001,
+
+            /* Fields used by child tables, as shift of the LSB and width */
+            FUNCT7_SHIFT = 25,
+            FUNCT7_BITS = 7,
+            FUNCT6_SHIFT = 26,      /* shifts by immediate, shamt[5] ignored */
+            FUNCT6_BITS = 6,
+            FUNCT5_SHIFT = 27,      /* AMOs, aq and rl ignored */
+            FUNCT5_BITS = 5,
+            RS2_SHIFT = 20,
+            REG_BITS = 5,
+            C_RS1_SHIFT = 7,
+            C_RS2_SHIFT = 2,
+        };
+    }
+
+    Decoder::Decoder(unsigned int xlen, std::uint32_t extensions) {
+        for (auto &e : root) {
+            set(e, UNKNOWN_EXTENSION, 0);
+        }
+
+        build_base();
+        if (extensions & extension_bit(M_EXTENSION)) {
+            build_m();
+        }
+        if (extensions & extension_bit(A_EXTENSION)) {
+            build_a();
+        }
+        if (extensions & extension_bit(C_EXTENSION)) {
+            build_c(xlen);
+        }
+    }
+
+    void Decoder::set(entry &e, extension_t extension, std::uint32_t code) {
+        e.extension = static_cast<std::uint8_t>(extension);
+        e.shift = 0;
+        e.bits = 0;
+        e.value = code;
+    }
+
+    std::uint32_t Decoder::split(bool in_root, std::size_t index, unsigned int shift, unsigned int bits) {
+        auto first = static_cast<std::uint32_t>(nodes.size());
+        entry old = in_root ? root[index] : nodes[index];
+
+        /* Children are appended, so references to nodes are not valid after this */
+        nodes.resize(nodes.size() + (1U << bits), old);
+
+        entry &e = in_root ? root[index] : nodes[index];
+        e.shift = static_cast<std::uint8_t>(shift);
+        e.bits = static_cast<std::uint8_t>(bits);
+        e.value = first;
+
+        return first;
+    }
+
+    void Decoder::build_base() {
+        for (std::uint32_t f3 = 0; f3 < 8; f3++) {
+            /* funct3 is part of the immediate or not checked */
+            set(root[full_index(LUI, f3)], BASE_EXTENSION, OP_LUI);
+            set(root[full_index(AUIPC, f3)], BASE_EXTENSION, OP_AUIPC);
+            set(root[full_index(JAL, f3)], BASE_EXTENSION, OP_JAL);
+            set(root[full_index(JALR, f3)], BASE_EXTENSION, OP_JALR);
+            set(root[full_index(FENCE, f3)], BASE_EXTENSION, OP_FENCE);
+        }
+
+        set(root[full_index(BEQ, BEQ_F)], BASE_EXTENSION, OP_BEQ);
+        set(root[full_index(BEQ, BNE_F)], BASE_EXTENSION, OP_BNE);
+        set(root[full_index(BEQ, BLT_F)], BASE_EXTENSION, OP_BLT);
+        set(root[full_index(BEQ, BGE_F)], BASE_EXTENSION, OP_BGE);
+        set(root[full_index(BEQ, BLTU_F)], BASE_EXTENSION, OP_BLTU);
+        set(root[full_index(BEQ, BGEU_F)], BASE_EXTENSION, OP_BGEU);
+
+        set(root[full_index(LB, LB_F)], BASE_EXTENSION, OP_LB);
+        set(root[full_index(LB, LH_F)], BASE_EXTENSION, OP_LH);
+        set(root[full_index(LB, LW_F)], BASE_EXTENSION, OP_LW);
+        set(root[full_index(LB, LD_F)], BASE_EXTENSION, OP_LD);
+        set(root[full_index(LB, LBU_F)], BASE_EXTENSION, OP_LBU);
+        set(root[full_index(LB, LHU_F)], BASE_EXTENSION, OP_LHU);
+        set(root[full_index(LB, LWU_F)], BASE_EXTENSION, OP_LWU);
+
+        set(root[full_index(SB, SB_F)], BASE_EXTENSION, OP_SB);
+        set(root[full_index(SB, SH_F)], BASE_EXTENSION, OP_SH);
+        set(root[full_index(SB, SW_F)], BASE_EXTENSION, OP_SW);
+        set(root[full_index(SB, SD_F)], BASE_EXTENSION, OP_SD);
+
+        set(root[full_index(ADDI, ADDI_F)], BASE_EXTENSION, OP_ADDI);
+        set(root[full_index(ADDI, SLTI_F)], BASE_EXTENSION, OP_SLTI);
+        set(root[full_index(ADDI, SLTIU_F)], BASE_EXTENSION, OP_SLTIU);
+        set(root[full_index(ADDI, XORI_F)], BASE_EXTENSION, OP_XORI);
+        set(root[full_index(ADDI, ORI_F)], BASE_EXTENSION, OP_ORI);
+        set(root[full_index(ADDI, ANDI_F)], BASE_EXTENSION, OP_ANDI);
+        set(root[full_index(ADDI, SLLI_F)], BASE_EXTENSION, OP_SLLI);
+        auto node = split(true, full_index(ADDI, SRLI_F), FUNCT6_SHIFT, FUNCT6_BITS);
+        set(nodes[node + SRLI_F7], BASE_EXTENSION, OP_SRLI);
+        set(nodes[node + SRAI_F7], BASE_EXTENSION, OP_SRAI);
+
+        set(root[full_index(ADDIW, ADDIW_F)], BASE_EXTENSION, OP_ADDIW);
+        set(root[full_index(ADDIW, SLLIW_F)], BASE_EXTENSION, OP_SLLIW);
+        node = split(true, full_index(ADDIW, SRLIW_F), FUNCT6_SHIFT, FUNCT6_BITS);
+        set(nodes[node + SRLIW_F7], BASE_EXTENSION, OP_SRLIW);
+        set(nodes[node + SRAIW_F7], BASE_EXTENSION, OP_SRAIW);
+
+        /* OP and OP-32 are split by funct7 for every funct3, M uses funct7 == 1 */
+        static constexpr std::array<opCodes, 8> op = {OP_ADD, OP_SLL, OP_SLT, OP_SLTU,
+                                                      OP_XOR, OP_SRL, OP_OR, OP_AND};
+        static constexpr std::array<opCodes, 8> op_32 = {OP_ADDW, OP_SLLW, OP_ERROR, OP_ERROR,
+                                                         OP_ERROR, OP_SRLW, OP_ERROR, OP_ERROR};
+        for (std::uint32_t f3 = 0; f3 < 8; f3++) {
+            node = split(true, full_index(ADD, f3), FUNCT7_SHIFT, FUNCT7_BITS);
+            set(nodes[node + ADD_F7], BASE_EXTENSION, op[f3]);
+
+            node = split(true, full_index(ADDW, f3), FUNCT7_SHIFT, FUNCT7_BITS);
+            if (op_32[f3] != OP_ERROR) {
+                set(nodes[node + ADD_F7], BASE_EXTENSION, op_32[f3]);
+            }
+        }
+        set(nodes[root[full_index(ADD, SUB_F)].value + SUB_F7], BASE_EXTENSION, OP_SUB);
+        set(nodes[root[full_index(ADD, SRA_F)].value + SRA_F7], BASE_EXTENSION, OP_SRA);
+        set(nodes[root[full_index(ADDW, ADDW_F)].value + SUB_F7], BASE_EXTENSION, OP_SUBW);
+        set(nodes[root[full_index(ADDW, SRLW)].value + SRA_F7], BASE_EXTENSION, OP_SRAW);
+
+        set(root[full_index(ECALL, CSRRW)], BASE_EXTENSION, OP_CSRRW);
+        set(root[full_index(ECALL, CSRRS)], BASE_EXTENSION, OP_CSRRS);
+        set(root[full_index(ECALL, CSRRC)], BASE_EXTENSION, OP_CSRRC);
+        set(root[full_index(ECALL, CSRRWI)], BASE_EXTENSION, OP_CSRRWI);
+        set(root[full_index(ECALL, CSRRSI)], BASE_EXTENSION, OP_CSRRSI);
+        set(root[full_index(ECALL, CSRRCI)], BASE_EXTENSION, OP_CSRRCI);
+
+        /* funct3 == 0: funct12 is funct7 and rs2, except SFENCE.VMA that has rs2 */
+        node = split(true, full_index(ECALL, ECALL_F3), FUNCT7_SHIFT, FUNCT7_BITS);
+        set(nodes[node + SFENCE_F], BASE_EXTENSION, OP_SFENCE);
+        static constexpr std::array<std::pair<std::uint32_t, opCodes>, 7> system = {{
+                {ECALL_F, OP_ECALL}, {EBREAK_F, OP_EBREAK}, {URET_F, OP_URET}, {SRET_F, OP_SRET},
+                {MRET_F, OP_MRET}, {WFI_F, OP_WFI}, {SFENCE_F, OP_SFENCE}}};
+        for (const auto &[funct12, code] : system) {
+            std::size_t index = node + (funct12 >> REG_BITS);
+            if (nodes[index].bits == 0) {
+                split(false, index, RS2_SHIFT, REG_BITS);
+            }
+            set(nodes[nodes[index].value + (funct12 & ((1U << REG_BITS) - 1))], BASE_EXTENSION, code);
+        }
+    }
+
+    void Decoder::build_m() {
+        static constexpr std::array<op_M_Codes, 8> op = {OP_M_MUL, OP_M_MULH, OP_M_MULHSU, OP_M_MULHU,
+                                                         OP_M_DIV, OP_M_DIVU, OP_M_REM, OP_M_REMU};
+        static constexpr std::array<op_M_Codes, 8> op_32 = {OP_M_MULW, OP_M_ERROR, OP_M_ERROR, OP_M_ERROR,
+                                                            OP_M_DIVW, OP_M_DIVUW, OP_M_REMW, OP_M_REMUW};
+
+        /* OP and OP-32 already split by funct7 in build_base() */
+        for (std::uint32_t f3 = 0; f3 < 8; f3++) {
+            set(nodes[root[full_index(ADD, f3)].value + M_F7], M_EXTENSION, op[f3]);
+            if (op_32[f3] != OP_M_ERROR) {
+                set(nodes[root[full_index(ADDW, f3)].value + M_F7], M_EXTENSION, op_32[f3]);
+            }
+        }
+    }
+
+    void Decoder::build_a() {
+        static constexpr std::array<std::pair<std::uint32_t, op_A_Codes>, 11> amo = {{
+                {A_LR, OP_A_LR}, {A_SC, OP_A_SC}, {A_AMOSWAP, OP_A_AMOSWAP}, {A_AMOADD, OP_A_AMOADD},
+                {A_AMOXOR, OP_A_AMOXOR}, {A_AMOAND, OP_A_AMOAND}, {A_AMOOR, OP_A_AMOOR},
+                {A_AMOMIN, OP_A_AMOMIN}, {A_AMOMAX, OP_A_AMOMAX}, {A_AMOMINU, OP_A_AMOMINU},
+                {A_AMOMAXU, OP_A_AMOMAXU}}};
+
+        /* .W and .D share the codes, the handler checks funct3 */
+        for (std::uint32_t f3 : {0b010U, 0b011U}) {
+            auto node = split(true, full_index(AMO, f3), FUNCT5_SHIFT, FUNCT5_BITS);
+            for (const auto &[funct5, code] : amo) {
+                set(nodes[node + funct5], A_EXTENSION, code);
+            }
+        }
+    }
+
+    void Decoder::build_c(unsigned int xlen) {
+        bool rv32 = (xlen == 32);
+
+        set(root[c_index(0b00, C_ADDI4SPN)], C_EXTENSION, OP_C_ADDI4SPN);
+        set(root[c_index(0b00, C_FLD)], C_EXTENSION, OP_C_FLD);
+        set(root[c_index(0b00, C_LW)], C_EXTENSION, OP_C_LW);
+        set(root[c_index(0b00, C_FLW)], C_EXTENSION, rv32 ? OP_C_FLW : OP_C_LD);
+        set(root[c_index(0b00, C_FSD)], C_EXTENSION, OP_C_FSD);
+        set(root[c_index(0b00, C_SW)], C_EXTENSION, OP_C_SW);
+        set(root[c_index(0b00, C_FSW)], C_EXTENSION, rv32 ? OP_C_FSW : OP_C_SD);
+
+        set(root[c_index(0b01, C_ADDI)], C_EXTENSION, OP_C_ADDI);
+        set(root[c_index(0b01, C_JAL)], C_EXTENSION, rv32 ? OP_C_JAL : OP_C_ADDIW);
+        set(root[c_index(0b01, C_LI)], C_EXTENSION, OP_C_LI);
+        /* C.LUI is told apart from C.ADDI16SP by its handler */
+        set(root[c_index(0b01, C_ADDI16SP)], C_EXTENSION, OP_C_ADDI16SP);
+        set(root[c_index(0b01, C_J)], C_EXTENSION, OP_C_J);
+        set(root[c_index(0b01, C_BEQZ)], C_EXTENSION, OP_C_BEQZ);
+        set(root[c_index(0b01, C_BNEZ)], C_EXTENSION, OP_C_BNEZ);
+
+        /* instr[11:10], then instr[6:5] and instr[12] for the register-register ones */
+        auto node = split(true, c_index(0b01, C_SRLI), 10, 2);
+        set(nodes[node + C_2_SRLI], C_EXTENSION, OP_C_SRLI);
+        set(nodes[node + C_2_SRAI], C_EXTENSION, OP_C_SRAI);
+        set(nodes[node + C_2_ANDI], C_EXTENSION, OP_C_ANDI);
+        node = split(false, node + C_2_SUB, 5, 2);
+        set(nodes[node + C_3_OR], C_EXTENSION, OP_C_OR);
+        set(nodes[node + C_3_AND], C_EXTENSION, OP_C_AND);
+        auto leaf = split(false, node + C_3_SUB, 12, 1);
+        set(nodes[leaf], C_EXTENSION, OP_C_SUB);
+        set(nodes[leaf + 1], C_EXTENSION, OP_C_SUBW);
+        leaf = split(false, node + C_3_XOR, 12, 1);
+        set(nodes[leaf], C_EXTENSION, OP_C_XOR);
+        set(nodes[leaf + 1], C_EXTENSION, OP_C_ADDW);
+
+        set(root[c_index(0b10, C_SLLI)], C_EXTENSION, OP_C_SLLI);
+        set(root[c_index(0b10, C_FLDSP)], C_EXTENSION, OP_C_LWSP);
+        set(root[c_index(0b10, C_LWSP)], C_EXTENSION, OP_C_LWSP);
+        set(root[c_index(0b10, C_FLWSP)], C_EXTENSION, rv32 ? OP_C_FLWSP : OP_C_LDSP);
+        set(root[c_index(0b10, C_SWSP)], C_EXTENSION, OP_C_SWSP);
+        set(root[c_index(0b10, C_FWWSP)], C_EXTENSION, rv32 ? OP_C_FSWSP : OP_C_SDSP);
+
+        /* instr[12], then rs2 == 0 and rs1 == 0 */
+        node = split(true, c_index(0b10, C_JR), 12, 1);
+        set(nodes[node], C_EXTENSION, OP_C_MV);
+        set(nodes[node + 1], C_EXTENSION, OP_C_ADD);
+        leaf = split(false, node, C_RS2_SHIFT, REG_BITS);
+        set(nodes[leaf], C_EXTENSION, OP_C_JR);
+        leaf = split(false, node + 1, C_RS2_SHIFT, REG_BITS);
+        set(nodes[leaf], C_EXTENSION, OP_C_JALR);
+        leaf = split(false, leaf, C_RS1_SHIFT, REG_BITS);
+        set(nodes[leaf], C_EXTENSION, OP_C_EBREAK);
+    }
+}
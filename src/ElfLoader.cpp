@@ -0,0 +1,178 @@
+/*!
+ \file ElfLoader.cpp
+ \brief ELF file loader and symbol table
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ElfLoader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace riscv_tlm {
+
+    void SymbolTable::add(const std::string &name, std::uint64_t address, std::uint64_t size) {
+        symbols.push_back({name, address, size});
+    }
+
+    void SymbolTable::sort() {
+        std::sort(symbols.begin(), symbols.end(),
+                  [](const elf_symbol &a, const elf_symbol &b) { return a.address < b.address; });
+    }
+
+    const elf_symbol *SymbolTable::find(std::uint64_t address) const {
+        auto it = std::upper_bound(symbols.begin(), symbols.end(), address,
+                                   [](std::uint64_t addr, const elf_symbol &sym) { return addr < sym.address; });
+
+        while (it != symbols.begin()) {
+            --it;
+            /* Symbols without size (labels) cover up to the next one */
+            if ((it->size == 0) || (address < it->address + it->size)) {
+                return &(*it);
+            }
+        }
+        return nullptr;
+    }
+
+    bool SymbolTable::getAddress(const std::string &name, std::uint64_t *address) const {
+        for (const auto &sym : symbols) {
+            if (sym.name == name) {
+                *address = sym.address;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ElfLoader::isElf(const std::string &filename) {
+        std::ifstream file(filename, std::ios::binary);
+        char magic[SELFMAG];
+
+        if (!file.read(magic, SELFMAG)) {
+            return false;
+        }
+        return std::memcmp(magic, ELFMAG, SELFMAG) == 0;
+    }
+
+    ElfLoader::ElfLoader(const std::string &filename) :
+            image(nullptr), image_size(0), valid(false), entry_point(0) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "ELF: cannot open " << filename << std::endl;
+            return;
+        }
+
+        struct stat st{};
+        if ((fstat(fd, &st) == 0) && (static_cast<std::size_t>(st.st_size) >= sizeof(Elf32_Ehdr))) {
+            void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                image = static_cast<const std::uint8_t *>(map);
+                image_size = st.st_size;
+            }
+        }
+        close(fd);
+
+        if (image == nullptr) {
+            std::cerr << "ELF: cannot map " << filename << std::endl;
+            return;
+        }
+
+        if ((std::memcmp(image, ELFMAG, SELFMAG) != 0) || (image[EI_DATA] != ELFDATA2LSB)) {
+            std::cerr << "ELF: " << filename << " is not a little endian ELF file" << std::endl;
+            return;
+        }
+
+        if (image[EI_CLASS] == ELFCLASS32) {
+            valid = parse<Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym>();
+        } else if (image[EI_CLASS] == ELFCLASS64) {
+            valid = parse<Elf64_Ehdr, Elf64_Phdr, Elf64_Shdr, Elf64_Sym>();
+        }
+
+        if (!valid) {
+            std::cerr << "ELF: " << filename << " is malformed" << std::endl;
+        }
+    }
+
+    ElfLoader::~ElfLoader() {
+        if (image != nullptr) {
+            munmap(const_cast<std::uint8_t *>(image), image_size);
+            image = nullptr;
+        }
+    }
+
+    template<typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+    bool ElfLoader::parse() {
+        if (image_size < sizeof(Ehdr)) {
+            return false;
+        }
+
+        const auto *ehdr = reinterpret_cast<const Ehdr *>(image);
+
+        if ((ehdr->e_machine != EM_RISCV) || (ehdr->e_phentsize != sizeof(Phdr)) ||
+            (ehdr->e_phoff + ehdr->e_phnum * sizeof(Phdr) > image_size)) {
+            return false;
+        }
+
+        entry_point = ehdr->e_entry;
+
+        const auto *phdr = reinterpret_cast<const Phdr *>(image + ehdr->e_phoff);
+        for (unsigned int i = 0; i < ehdr->e_phnum; i++) {
+            if ((phdr[i].p_type != PT_LOAD) || (phdr[i].p_memsz == 0)) {
+                continue;
+            }
+            if ((phdr[i].p_offset + phdr[i].p_filesz > image_size) || (phdr[i].p_filesz > phdr[i].p_memsz)) {
+                return false;
+            }
+            segments.push_back({phdr[i].p_paddr, image + phdr[i].p_offset, phdr[i].p_filesz, phdr[i].p_memsz});
+        }
+
+        /* Symbols are optional (stripped files) */
+        if ((ehdr->e_shoff == 0) || (ehdr->e_shentsize != sizeof(Shdr)) ||
+            (ehdr->e_shoff + ehdr->e_shnum * sizeof(Shdr) > image_size)) {
+            return true;
+        }
+
+        const auto *shdr = reinterpret_cast<const Shdr *>(image + ehdr->e_shoff);
+        for (unsigned int i = 0; i < ehdr->e_shnum; i++) {
+            if ((shdr[i].sh_type != SHT_SYMTAB) || (shdr[i].sh_link >= ehdr->e_shnum)) {
+                continue;
+            }
+
+            const Shdr &strtab = shdr[shdr[i].sh_link];
+            if ((shdr[i].sh_offset + shdr[i].sh_size > image_size) ||
+                (strtab.sh_offset + strtab.sh_size > image_size)) {
+                continue;
+            }
+
+            const auto *sym = reinterpret_cast<const Sym *>(image + shdr[i].sh_offset);
+            const char *names = reinterpret_cast<const char *>(image + strtab.sh_offset);
+            std::size_t count = shdr[i].sh_size / sizeof(Sym);
+
+            for (std::size_t j = 0; j < count; j++) {
+                unsigned int type = ELF64_ST_TYPE(sym[j].st_info);
+
+                if ((sym[j].st_name == 0) || (sym[j].st_name >= strtab.sh_size) ||
+                    (sym[j].st_shndx == SHN_UNDEF) ||
+                    ((type != STT_FUNC) && (type != STT_OBJECT) && (type != STT_NOTYPE))) {
+                    continue;
+                }
+                symbols.add(std::string(names + sym[j].st_name,
+                                        strnlen(names + sym[j].st_name, strtab.sh_size - sym[j].st_name)),
+                            sym[j].st_value, sym[j].st_size);
+            }
+        }
+        symbols.sort();
+
+        return true;
+    }
+}
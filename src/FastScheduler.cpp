@@ -0,0 +1,61 @@
+/*!
+ \file FastScheduler.cpp
+ \brief Event queue for the standalone (no SystemC kernel) mode
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "FastScheduler.h"
+
+#include <utility>
+
+#include "systemc"
+
+namespace riscv_tlm {
+
+    FastScheduler *FastScheduler::getInstance() {
+        if (instance == nullptr) {
+            instance = new FastScheduler();
+        }
+
+        return instance;
+    }
+
+    std::uint64_t FastScheduler::time_stamp() {
+        if ((instance != nullptr) && instance->enabled) {
+            return instance->current_time;
+        }
+        return sc_core::sc_time_stamp().value();
+    }
+
+    FastScheduler::FastScheduler() : enabled(false), current_time(0), sequence(0) {
+    }
+
+    void FastScheduler::schedule(std::uint64_t time, callback_t callback) {
+        events.push(event{time, sequence++, std::move(callback)});
+    }
+
+    bool FastScheduler::run_next() {
+        if (events.empty()) {
+            return false;
+        }
+
+        if (events.top().time > current_time) {
+            current_time = events.top().time;
+        }
+        run_events();
+        return true;
+    }
+
+    void FastScheduler::run_events() {
+        /* Callbacks may post new events, even already due ones */
+        while (!events.empty() && (events.top().time <= current_time)) {
+            callback_t callback = events.top().callback;
+            events.pop();
+            callback();
+        }
+    }
+
+    FastScheduler *FastScheduler::instance = nullptr;
+}
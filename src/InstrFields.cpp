@@ -0,0 +1,111 @@
+/*!
+ \file InstrFields.cpp
+ \brief Compile-time checks of the instruction field decoders
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "InstrFields.h"
+
+/*
+ * Encodings produced by an assembler (llvm-mc -triple=riscv64 -mattr=+a,+c).
+ * Each format is checked at both ends of its immediate range, so a wrong
+ * bit position or sign extension fails the build.
+ */
+namespace riscv_tlm::fields {
+
+    /* helpers */
+    static_assert(bits(0xF0000000, 31, 28) == 0xF);
+    static_assert(bits(0x12345678, 31, 0) == 0x12345678);
+    static_assert(sign_extend(0x800, 12) == -2048);
+    static_assert(sign_extend(0x7FF, 12) == 2047);
+    static_assert(sign_extend(0xFFFFF800, 12) == -2048);
+
+    /* I-type: addi t0, t1, -2048 / addi t6, ra, 2047 */
+    static_assert(opcode(0x80030293) == 0b0010011);
+    static_assert(rd(0x80030293) == 5 && rs1(0x80030293) == 6 && funct3(0x80030293) == 0);
+    static_assert(imm_I(0x80030293) == -2048);
+    static_assert(rd(0x7ff08f93) == 31 && rs1(0x7ff08f93) == 1 && imm_I(0x7ff08f93) == 2047);
+
+    /* S-type: sw t2, -4(s0) / sd s1, 2047(a0) */
+    static_assert(rs1(0xfe742e23) == 8 && rs2(0xfe742e23) == 7 && funct3(0xfe742e23) == 0b010);
+    static_assert(imm_S(0xfe742e23) == -4);
+    static_assert(rs1(0x7e953fa3) == 10 && rs2(0x7e953fa3) == 9 && funct3(0x7e953fa3) == 0b011);
+    static_assert(imm_S(0x7e953fa3) == 2047);
+
+    /* B-type: beq ra, sp, -4096 / bne gp, tp, 4094 */
+    static_assert(rs1(0x80208063) == 1 && rs2(0x80208063) == 2 && imm_B(0x80208063) == -4096);
+    static_assert(rs1(0x7e419fe3) == 3 && rs2(0x7e419fe3) == 4 && imm_B(0x7e419fe3) == 4094);
+
+    /* U-type: lui gp, 0xfffff / auipc tp, 0x12345 */
+    static_assert(rd(0xfffff1b7) == 3 && imm_U(0xfffff1b7) == 0xFFFFF);
+    static_assert(rd(0x12345217) == 4 && imm_U(0x12345217) == 0x12345);
+
+    /* J-type: jal ra, -1048576 / jal zero, 1048574 */
+    static_assert(rd(0x800000ef) == 1 && imm_J(0x800000ef) == -1048576);
+    static_assert(rd(0x7ffff06f) == 0 && imm_J(0x7ffff06f) == 1048574);
+
+    /* R-type and shifts: sub t0, t1, t2 / slli ra, sp, 63 (RV64) / srai gp, tp, 5 */
+    static_assert(rd(0x407302b3) == 5 && rs1(0x407302b3) == 6 && rs2(0x407302b3) == 7);
+    static_assert(funct7(0x407302b3) == 0b0100000 && funct3(0x407302b3) == 0);
+    static_assert(rd(0x03f11093) == 1 && rs1(0x03f11093) == 2 && shamt(0x03f11093) == 63);
+    static_assert(shamt(0x40525193) == 5 && rs2(0x40525193) == 5 && funct7(0x40525193) == 0b0100000);
+
+    /* CSR: csrrw ra, mstatus, sp */
+    static_assert(csr(0x300110f3) == 0x300 && rd(0x300110f3) == 1 && rs1(0x300110f3) == 2);
+
+    /* AMO: amoswap.w.aqrl ra, sp, (gp) / sc.d tp, t0, (t1) */
+    static_assert(funct5(0x0e21a0af) == 0b00001 && funct3(0x0e21a0af) == 0b010);
+    static_assert(rd(0x0e21a0af) == 1 && rs1(0x0e21a0af) == 3 && rs2(0x0e21a0af) == 2);
+    static_assert(funct5(0x1853322f) == 0b00011 && funct3(0x1853322f) == 0b011);
+
+    /* CIW: c.addi4spn s0, sp, 1020 / c.addi4spn a5, sp, 4 */
+    static_assert(c_op(0x1fe0) == 0b00 && c_funct3(0x1fe0) == 0b000);
+    static_assert(c_rdp(0x1fe0) == 8 && c_imm_ADDI4SPN(0x1fe0) == 1020);
+    static_assert(c_rdp(0x005c) == 15 && c_imm_ADDI4SPN(0x005c) == 4);
+
+    /* CL/CS word: c.lw s1, 124(a0) / c.sw a5, 4(s0) */
+    static_assert(c_rdp(0x5d64) == 9 && c_rs1p(0x5d64) == 10 && c_imm_L(0x5d64) == 124);
+    static_assert(c_rs2p(0xc05c) == 15 && c_rs1p(0xc05c) == 8 && c_imm_L(0xc05c) == 4);
+
+    /* CL/CS double: c.ld s1, 248(a0) / c.sd s0, 8(a5) */
+    static_assert(c_rdp(0x7d64) == 9 && c_rs1p(0x7d64) == 10 && c_imm_CL(0x7d64) == 248);
+    static_assert(c_rs2p(0xe780) == 8 && c_rs1p(0xe780) == 15 && c_imm_CL(0xe780) == 8);
+
+    /* CI: c.addi t0, -32 / c.addi t1, 31 / c.srai s1, 63 */
+    static_assert(c_op(0x1281) == 0b01 && c_rs1(0x1281) == 5 && c_imm_ADDI(0x1281) == -32);
+    static_assert(c_rs1(0x037d) == 6 && c_imm_ADDI(0x037d) == 31);
+    static_assert(c_rs1p(0x94fd) == 9 && c_shamt(0x94fd) == 63);
+
+    /* CI shift: c.slli a0, 32 */
+    static_assert(c_rs1(0x1502) == 10 && c_shamt(0x1502) == 32);
+
+    /* C.ADDI16SP: -512 / 496 */
+    static_assert(c_rs1(0x7101) == 2 && c_imm_ADDI16SP(0x7101) == -512);
+    static_assert(c_imm_ADDI16SP(0x617d) == 496);
+
+    /* C.LUI: c.lui t0, 0xfffe0 / c.lui t1, 0x1f */
+    static_assert(c_rs1(0x7281) == 5 && c_imm_LUI(0x7281) == -32 * 4096);
+    static_assert(c_rs1(0x637d) == 6 && c_imm_LUI(0x637d) == 31 * 4096);
+
+    /* CJ: c.j -2048 / c.j 2046 */
+    static_assert(c_funct3(0xb001) == 0b101 && c_imm_J(0xb001) == -2048);
+    static_assert(c_imm_J(0xaffd) == 2046);
+
+    /* CB: c.beqz s0, -256 / c.bnez a5, 254 */
+    static_assert(c_rs1p(0xd001) == 8 && c_imm_CB(0xd001) == -256);
+    static_assert(c_rs1p(0xeffd) == 15 && c_imm_CB(0xeffd) == 254);
+
+    /* CI loads: c.lwsp t0, 252(sp) / c.ldsp t0, 504(sp) */
+    static_assert(c_op(0x52fe) == 0b10 && c_rs1(0x52fe) == 5 && c_imm_LWSP(0x52fe) == 252);
+    static_assert(c_rs1(0x72fe) == 5 && c_imm_LDSP(0x72fe) == 504);
+
+    /* CSS: c.swsp t0, 252(sp) / c.sdsp t6, 504(sp) */
+    static_assert(c_rs2(0xdf96) == 5 && c_imm_CSS(0xdf96) == 252);
+    static_assert(c_rs2(0xfffe) == 31 && c_imm_CSDSP(0xfffe) == 504);
+
+    /* CR and CA: c.add t0, t1 / c.sub s0, a5 */
+    static_assert(c_rs1(0x929a) == 5 && c_rs2(0x929a) == 6);
+    static_assert(c_rs1p(0x8c1d) == 8 && c_rs2p(0x8c1d) == 15);
+}
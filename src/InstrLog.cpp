@@ -0,0 +1,165 @@
+/*!
+ \file InstrLog.cpp
+ \brief Instruction trace: debug log macro and binary commit trace writer
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "InstrLog.h"
+
+#include <cstring>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace riscv_tlm {
+
+    InstrLog::InstrLog(const std::string &filename, unsigned int xlen, trace::codec_t codec) :
+            out(filename, std::ios::binary), codec(codec),
+            xlen_mask((xlen == 32) ? 0xFFFFFFFFULL : ~0ULL),
+            active(&buffers[0]), active_size(0), active_records(0),
+            pending(nullptr), pending_size(0), pending_records(0), done(false),
+            next_pc(0), prev_mem_addr(0), rd(0), rd_value(0), mem_flags(0), mem_size(0),
+            mem_addr(0), mem_data(0) {
+
+        if (!out.is_open()) {
+            return;
+        }
+
+        if (!codecAvailable(codec)) {
+            this->codec = trace::CODEC_NONE;
+        }
+
+        trace::file_header header{};
+        std::memcpy(header.magic, "RVTLMTRC", sizeof(header.magic));
+        header.version = trace::VERSION;
+        header.xlen = static_cast<std::uint8_t>(xlen);
+        header.codec = this->codec;
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        for (auto &buffer : buffers) {
+            buffer.resize(trace::BLOCK_SIZE + trace::MAX_RECORD_SIZE);
+        }
+
+        writer_thread = std::thread(&InstrLog::writer, this);
+    }
+
+    InstrLog::~InstrLog() {
+        if (!writer_thread.joinable()) {
+            return;
+        }
+
+        if (active_size != 0) {
+            hand_over();
+        }
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            done = true;
+        }
+        cond.notify_all();
+        writer_thread.join();
+    }
+
+    bool InstrLog::codecAvailable(trace::codec_t codec) {
+        switch (codec) {
+            case trace::CODEC_NONE:
+                return true;
+#ifdef HAVE_LZ4
+            case trace::CODEC_LZ4:
+                return true;
+#endif
+#ifdef HAVE_ZSTD
+            case trace::CODEC_ZSTD:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    void InstrLog::hand_over() {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            /* Writer still busy with the other buffer? then the disk is the bottleneck */
+            cond.wait(guard, [this]() { return pending == nullptr; });
+            pending = active;
+            pending_size = active_size;
+            pending_records = active_records;
+        }
+        cond.notify_all();
+
+        active = (active == &buffers[0]) ? &buffers[1] : &buffers[0];
+        active_size = 0;
+        active_records = 0;
+
+        /* Blocks are decoded on their own */
+        next_pc = 0;
+        prev_mem_addr = 0;
+    }
+
+    void InstrLog::writer() {
+        std::unique_lock<std::mutex> guard(lock);
+
+        while (true) {
+            cond.wait(guard, [this]() { return (pending != nullptr) || done; });
+            if (pending == nullptr) {
+                return;
+            }
+
+            /* CPU can fill the other buffer meanwhile */
+            guard.unlock();
+            write_block(*pending, pending_size, pending_records);
+            guard.lock();
+
+            pending = nullptr;
+            cond.notify_all();
+        }
+    }
+
+    void InstrLog::write_block(const std::vector<std::uint8_t> &data, std::size_t size, std::uint32_t records) {
+        [[maybe_unused]] static thread_local std::vector<char> compressed;
+        trace::block_header header{};
+        const char *stored = reinterpret_cast<const char *>(data.data());
+
+        header.raw_size = static_cast<std::uint32_t>(size);
+        header.stored_size = header.raw_size;
+        header.records = records;
+
+        switch (codec) {
+#ifdef HAVE_LZ4
+            case trace::CODEC_LZ4: {
+                compressed.resize(LZ4_compressBound(static_cast<int>(size)));
+                int len = LZ4_compress_default(stored, compressed.data(), static_cast<int>(size),
+                                               static_cast<int>(compressed.size()));
+                if ((len > 0) && (static_cast<std::size_t>(len) < size)) {
+                    header.stored_size = static_cast<std::uint32_t>(len);
+                    stored = compressed.data();
+                }
+                break;
+            }
+#endif
+#ifdef HAVE_ZSTD
+            case trace::CODEC_ZSTD: {
+                compressed.resize(ZSTD_compressBound(size));
+                std::size_t len = ZSTD_compress(compressed.data(), compressed.size(), stored, size, 3);
+                if (!ZSTD_isError(len) && (len < size)) {
+                    header.stored_size = static_cast<std::uint32_t>(len);
+                    stored = compressed.data();
+                }
+                break;
+            }
+#endif
+            default:
+                break;
+        }
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(stored, header.stored_size);
+    }
+}
@@ -0,0 +1,601 @@
+/*!
+ \file JIT.cpp
+ \brief Translator of hot basic blocks to native x86-64 code
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "JIT.h"
+#include "A_extension.h"
+#include "InstrFields.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace riscv_tlm {
+
+    /* x86-64 registers used by the translated code */
+    enum {
+        X86_EAX = 0,
+        X86_ECX = 1,
+    };
+
+    template<typename T>
+    JIT<T>::JIT(Registers<T> *register_bank, BASE_ISA<T> *base_isa, C_extension<T> *c_ext, helper_t helper_fn) :
+            regs(register_bank), base_inst(base_isa), c_inst(c_ext), helper(helper_fn),
+            code_buffer(nullptr), code_used(0), overflow(false) {
+
+        pc_offset = static_cast<std::int32_t>(reinterpret_cast<std::uint8_t *>(regs->getRawPC()) -
+                                              reinterpret_cast<std::uint8_t *>(regs->getRawRegisters()));
+
+#if defined(__x86_64__)
+        /* Never writable and executable at the same time, compile() switches it */
+        void *buffer = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffer != MAP_FAILED) {
+            code_buffer = static_cast<std::uint8_t *>(buffer);
+        } else {
+            std::cerr << "JIT: cannot allocate executable memory, using block interpreter" << std::endl;
+        }
+#else
+        std::cerr << "JIT: host is not x86-64, using block interpreter" << std::endl;
+#endif
+    }
+
+    template<typename T>
+    JIT<T>::~JIT() {
+        if (code_buffer != nullptr) {
+            munmap(code_buffer, CODE_BUFFER_SIZE);
+            code_buffer = nullptr;
+        }
+    }
+
+    template<typename T>
+    void JIT<T>::flush() {
+        code_used = 0;
+    }
+
+    template<typename T>
+    bool JIT<T>::protect_tail(std::size_t offset, bool writable) {
+        /* From the page holding offset to the end of the buffer */
+        auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::size_t start = offset - (offset % page_size);
+        int prot = writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC);
+
+        if (mprotect(code_buffer + start, CODE_BUFFER_SIZE - start, prot) != 0) {
+            std::cerr << "JIT: cannot change code buffer protection, block stays interpreted" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool JIT<T>::lower(const decoded_instr &entry, jit_uop *uop) {
+        constexpr bool rv64 = sizeof(T) == 8;
+
+        uop->use_imm = false;
+        uop->imm = 0;
+        uop->rs1 = 0;
+        uop->rs2 = 0;
+
+        if (entry.extension == BASE_EXTENSION) {
+            base_inst->setInstr(entry.instr);
+            uop->rd = base_inst->get_rd();
+            uop->rs1 = base_inst->get_rs1();
+            uop->rs2 = base_inst->get_rs2();
+
+            switch (static_cast<opCodes>(entry.code)) {
+                case OP_LUI:
+                    uop->op = JIT_MOVI;
+                    uop->imm = static_cast<std::int32_t>(base_inst->get_imm_U() << 12);
+                    return true;
+                case OP_AUIPC:
+                    uop->op = JIT_MOVI;
+                    uop->imm = static_cast<signed_T>(static_cast<unsigned_T>(entry.pc) +
+                            static_cast<unsigned_T>(static_cast<std::int32_t>(base_inst->get_imm_U() << 12)));
+                    return true;
+                case OP_ADDI:
+                    uop->op = JIT_ADD;
+                    break;
+                case OP_XORI:
+                    uop->op = JIT_XOR;
+                    break;
+                case OP_ORI:
+                    uop->op = JIT_OR;
+                    break;
+                case OP_ANDI:
+                    uop->op = JIT_AND;
+                    break;
+                case OP_SLTI:
+                    uop->op = JIT_SLT;
+                    break;
+                case OP_SLTIU:
+                    uop->op = JIT_SLTU;
+                    break;
+                case OP_ADD:
+                    uop->op = JIT_ADD;
+                    return true;
+                case OP_SUB:
+                    uop->op = JIT_SUB;
+                    return true;
+                case OP_XOR:
+                    uop->op = JIT_XOR;
+                    return true;
+                case OP_OR:
+                    uop->op = JIT_OR;
+                    return true;
+                case OP_AND:
+                    uop->op = JIT_AND;
+                    return true;
+                case OP_SLT:
+                    uop->op = JIT_SLT;
+                    return true;
+                case OP_SLTU:
+                    uop->op = JIT_SLTU;
+                    return true;
+                case OP_ADDIW:
+                    if (!rv64) {
+                        return false;
+                    }
+                    uop->op = JIT_ADDW;
+                    break;
+                case OP_ADDW:
+                    uop->op = JIT_ADDW;
+                    return rv64;
+                case OP_SUBW:
+                    uop->op = JIT_SUBW;
+                    return rv64;
+                default:
+                    return false;
+            }
+
+            /* register-immediate forms */
+            uop->use_imm = true;
+            uop->imm = base_inst->get_imm_I();
+            return true;
+        }
+
+        if (entry.extension == C_EXTENSION) {
+            c_inst->setInstr(entry.instr);
+
+            switch (static_cast<op_C_Codes>(entry.code)) {
+                case OP_C_LI:
+                    uop->op = JIT_MOVI;
+                    uop->rd = c_inst->get_rd();
+                    uop->imm = c_inst->get_imm_ADDI();
+                    return true;
+                case OP_C_MV:
+                    uop->op = JIT_ADD;
+                    uop->rd = c_inst->get_rd();
+                    uop->rs1 = c_inst->get_rs2();
+                    uop->use_imm = true;
+                    return true;
+                case OP_C_ADD:
+                    uop->op = JIT_ADD;
+                    uop->rd = c_inst->get_rs1();
+                    uop->rs1 = c_inst->get_rs1();
+                    uop->rs2 = c_inst->get_rs2();
+                    return true;
+                case OP_C_ADDI:
+                    uop->op = JIT_ADD;
+                    uop->rd = c_inst->get_rd();
+                    uop->rs1 = uop->rd;
+                    uop->use_imm = true;
+                    uop->imm = c_inst->get_imm_ADDI();
+                    return true;
+                case OP_C_ANDI:
+                    uop->op = JIT_AND;
+                    uop->rd = c_inst->get_rs1p();
+                    uop->rs1 = uop->rd;
+                    uop->use_imm = true;
+                    uop->imm = c_inst->get_imm_ADDI();
+                    return true;
+                case OP_C_SUB:
+                    uop->op = JIT_SUB;
+                    break;
+                case OP_C_XOR:
+                    uop->op = JIT_XOR;
+                    break;
+                case OP_C_OR:
+                    uop->op = JIT_OR;
+                    break;
+                case OP_C_AND:
+                    uop->op = JIT_AND;
+                    break;
+                default:
+                    return false;
+            }
+
+            /* CA format: rd' = rd' op rs2' */
+            uop->rd = c_inst->get_rs1p();
+            uop->rs1 = uop->rd;
+            uop->rs2 = c_inst->get_rs2p();
+            return true;
+        }
+
+        return false;
+    }
+
+    template<typename T>
+    bool JIT<T>::is_native(const decoded_instr &entry) {
+        jit_uop uop{};
+        return lower(entry, &uop);
+    }
+
+    template<typename T>
+    bool JIT<T>::is_replayable(const decoded_instr &entry) {
+        switch (entry.extension) {
+            case BASE_EXTENSION: {
+                auto code = static_cast<opCodes>(entry.code);
+                return (code != OP_ECALL) && (code != OP_EBREAK);
+            }
+            case A_EXTENSION:
+                return static_cast<op_A_Codes>(entry.code) != OP_A_SC;
+            case C_EXTENSION:
+                return static_cast<op_C_Codes>(entry.code) != OP_C_EBREAK;
+            default:
+                return true;
+        }
+    }
+
+    template<typename T>
+    bool JIT<T>::may_write_csrs(const decoded_instr &entry) {
+        if (is_native(entry) || (entry.extension == M_EXTENSION)) {
+            return false;
+        }
+
+        if (entry.extension == BASE_EXTENSION) {
+            switch (static_cast<opCodes>(entry.code)) {
+                case OP_JAL:
+                case OP_JALR:
+                case OP_BEQ:
+                case OP_BNE:
+                case OP_BLT:
+                case OP_BGE:
+                case OP_BLTU:
+                case OP_BGEU:
+                case OP_LB:
+                case OP_LH:
+                case OP_LW:
+                case OP_LBU:
+                case OP_LHU:
+                case OP_LWU:
+                case OP_LD:
+                case OP_SB:
+                case OP_SH:
+                case OP_SW:
+                case OP_SD:
+                case OP_SLL:
+                case OP_SRL:
+                case OP_SRA:
+                case OP_SLLW:
+                case OP_SRLW:
+                case OP_SRAW:
+                case OP_SRLI:
+                case OP_SRAI:
+                case OP_SRAIW:
+                case OP_FENCE:
+                case OP_WFI:
+                    return false;
+                /* Illegal shift amounts raise an exception */
+                case OP_SLLI:
+                    return (sizeof(T) == 4) && (fields::shamt(entry.instr) >= 0x20);
+                case OP_SLLIW:
+                case OP_SRLIW:
+                    return fields::shamt(entry.instr) >= 0x20;
+                default:
+                    return true;
+            }
+        }
+
+        if (entry.extension == C_EXTENSION) {
+            switch (static_cast<op_C_Codes>(entry.code)) {
+                case OP_C_JAL:
+                case OP_C_J:
+                case OP_C_JR:
+                case OP_C_JALR:
+                case OP_C_BEQZ:
+                case OP_C_BNEZ:
+                case OP_C_LW:
+                case OP_C_LD:
+                case OP_C_SW:
+                case OP_C_SD:
+                case OP_C_LWSP:
+                case OP_C_LDSP:
+                case OP_C_SWSP:
+                case OP_C_SDSP:
+                case OP_C_NOP:
+                case OP_C_ADDIW:
+                case OP_C_ADDI16SP:
+                case OP_C_LUI:
+                case OP_C_SUBW:
+                case OP_C_ADDW:
+                case OP_C_SLLI:
+                case OP_C_SRLI:
+                case OP_C_SRAI:
+                    return false;
+                /* Zero immediate is illegal */
+                case OP_C_ADDI4SPN:
+                    return fields::bits(entry.instr, 12, 5) == 0;
+                default:
+                    return true;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T>
+    void JIT<T>::emit8(std::uint8_t byte) {
+        if (code_used < CODE_BUFFER_SIZE) {
+            code_buffer[code_used] = byte;
+        } else {
+            overflow = true;
+        }
+        code_used++;
+    }
+
+    template<typename T>
+    void JIT<T>::emit32(std::uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            emit8(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    template<typename T>
+    void JIT<T>::emit64(std::uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            emit8(static_cast<std::uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    /* REX.W prefix, only for XLEN 64 operations */
+    template<typename T>
+    void JIT<T>::emit_rex() {
+        if (sizeof(T) == 8) {
+            emit8(0x48);
+        }
+    }
+
+    /* mov x86_reg, [rbx + reg * XLEN] */
+    template<typename T>
+    void JIT<T>::emit_load(unsigned int x86_reg, unsigned int reg, bool wide) {
+        if (wide) {
+            emit_rex();
+        }
+        emit8(0x8B);
+        emit8(0x80 | (x86_reg << 3) | 0x03);
+        emit32(reg * sizeof(T));
+    }
+
+    /* mov [rbx + reg * XLEN], x86_reg */
+    template<typename T>
+    void JIT<T>::emit_store(unsigned int x86_reg, unsigned int reg, bool wide) {
+        if (wide) {
+            emit_rex();
+        }
+        emit8(0x89);
+        emit8(0x80 | (x86_reg << 3) | 0x03);
+        emit32(reg * sizeof(T));
+    }
+
+    template<typename T>
+    void JIT<T>::emit_uop(const jit_uop &uop) {
+        /* x0 is hardwired to 0, instruction has no effect */
+        if (uop.rd == 0) {
+            return;
+        }
+
+        /* opcodes for "op eax, [mem]" and "op eax, imm32" */
+        std::uint8_t op_mem = 0;
+        std::uint8_t op_imm = 0;
+
+        switch (uop.op) {
+            case JIT_MOVI:
+                if (sizeof(T) == 8) {
+                    emit8(0x48);    // mov rax, imm64
+                    emit8(0xB8);
+                    emit64(static_cast<std::uint64_t>(uop.imm));
+                } else {
+                    emit8(0xB8);    // mov eax, imm32
+                    emit32(static_cast<std::uint32_t>(uop.imm));
+                }
+                emit_store(X86_EAX, uop.rd, true);
+                return;
+            case JIT_SLT:
+            case JIT_SLTU:
+                emit_load(X86_EAX, uop.rs1, true);
+                emit8(0x31);        // xor ecx, ecx
+                emit8(0xC9);
+                emit_rex();
+                if (uop.use_imm) {
+                    emit8(0x3D);    // cmp eax, imm32
+                    emit32(static_cast<std::uint32_t>(uop.imm));
+                } else {
+                    emit8(0x3B);    // cmp eax, [mem]
+                    emit8(0x83);
+                    emit32(uop.rs2 * sizeof(T));
+                }
+                emit8(0x0F);        // setl cl / setb cl
+                emit8((uop.op == JIT_SLT) ? 0x9C : 0x92);
+                emit8(0xC1);
+                emit_store(X86_ECX, uop.rd, true);
+                return;
+            case JIT_ADD:
+            case JIT_ADDW:
+                op_mem = 0x03;
+                op_imm = 0x05;
+                break;
+            case JIT_SUB:
+            case JIT_SUBW:
+                op_mem = 0x2B;
+                op_imm = 0x2D;
+                break;
+            case JIT_XOR:
+                op_mem = 0x33;
+                op_imm = 0x35;
+                break;
+            case JIT_OR:
+                op_mem = 0x0B;
+                op_imm = 0x0D;
+                break;
+            case JIT_AND:
+                op_mem = 0x23;
+                op_imm = 0x25;
+                break;
+        }
+
+        /* W operations work on 32 bits and sign extend the result */
+        bool wide = (uop.op != JIT_ADDW) && (uop.op != JIT_SUBW);
+
+        emit_load(X86_EAX, uop.rs1, wide);
+        if (wide) {
+            emit_rex();
+        }
+        if (uop.use_imm) {
+            emit8(op_imm);
+            emit32(static_cast<std::uint32_t>(uop.imm));
+        } else {
+            emit8(op_mem);
+            emit8(0x83);
+            emit32(uop.rs2 * sizeof(T));
+        }
+        if (!wide) {
+            emit8(0x48);            // movsxd rax, eax
+            emit8(0x63);
+            emit8(0xC0);
+        }
+        emit_store(X86_EAX, uop.rd, true);
+    }
+
+    template<typename T>
+    void JIT<T>::emit_set_pc(std::uint64_t pc) {
+        if (sizeof(T) == 8) {
+            emit8(0x48);            // mov rax, imm64
+            emit8(0xB8);
+            emit64(pc);
+            emit8(0x48);            // mov [rbx + pc_offset], rax
+            emit8(0x89);
+            emit8(0x83);
+            emit32(static_cast<std::uint32_t>(pc_offset));
+        } else {
+            emit8(0xC7);            // mov dword [rbx + pc_offset], imm32
+            emit8(0x83);
+            emit32(static_cast<std::uint32_t>(pc_offset));
+            emit32(static_cast<std::uint32_t>(pc));
+        }
+    }
+
+    template<typename T>
+    void JIT<T>::emit_helper_call(const void *arg) {
+        emit8(0x4C);                // mov rdi, r12
+        emit8(0x89);
+        emit8(0xE7);
+        emit8(0x48);                // mov rsi, imm64
+        emit8(0xBE);
+        emit64(reinterpret_cast<std::uint64_t>(arg));
+        emit8(0x48);                // mov rax, imm64
+        emit8(0xB8);
+        emit64(reinterpret_cast<std::uint64_t>(helper));
+        emit8(0xFF);                // call rax
+        emit8(0xD0);
+    }
+
+    /* 13 bytes long, jumps over it are hardcoded */
+    template<typename T>
+    void JIT<T>::emit_exit(unsigned int executed) {
+        emit8(0xB8);                // mov eax, executed
+        emit32(executed);
+        emit8(0x48);                // add rsp, 8
+        emit8(0x83);
+        emit8(0xC4);
+        emit8(0x08);
+        emit8(0x41);                // pop r12
+        emit8(0x5C);
+        emit8(0x5B);                // pop rbx
+        emit8(0xC3);                // ret
+    }
+
+    template<typename T>
+    typename JIT<T>::native_block JIT<T>::compile(const std::vector<jit_op> &ops) {
+        if ((code_buffer == nullptr) || ops.empty()) {
+            return nullptr;
+        }
+
+        std::size_t start = code_used;
+        overflow = false;
+
+        if ((start >= CODE_BUFFER_SIZE) || !protect_tail(start, true)) {
+            return nullptr;
+        }
+
+        /* Prologue: rbx = register bank, r12 = cpu, stack 16 bytes aligned */
+        emit8(0x53);                // push rbx
+        emit8(0x41);                // push r12
+        emit8(0x54);
+        emit8(0x48);                // sub rsp, 8
+        emit8(0x83);
+        emit8(0xEC);
+        emit8(0x08);
+        emit8(0x48);                // mov rbx, rdi
+        emit8(0x89);
+        emit8(0xFB);
+        emit8(0x49);                // mov r12, rsi
+        emit8(0x89);
+        emit8(0xF4);
+
+        unsigned int executed = 0;
+        bool last_native = false;
+
+        for (const auto &op : ops) {
+            jit_uop uop{};
+            executed++;
+
+            if (lower(*op.instr, &uop)) {
+                emit_uop(uop);
+                last_native = true;
+                continue;
+            }
+
+            /* Interpreter needs the right PC (exceptions, AUIPC-like uses) */
+            emit_set_pc(op.instr->pc);
+            emit_helper_call(op.helper_arg);
+            last_native = false;
+
+            if (executed != ops.size()) {
+                emit8(0x84);        // test al, al
+                emit8(0xC0);
+                emit8(0x75);        // jnz over the exit sequence
+                emit8(0x0D);
+                emit_exit(executed);
+            }
+        }
+
+        if (last_native) {
+            const jit_op &last = ops.back();
+            emit_set_pc(last.instr->pc + last.length);
+        }
+        emit_exit(executed);
+
+        /* Earlier blocks on the first page are executable again too */
+        bool executable = protect_tail(start, false);
+
+        if (overflow) {
+            /* Buffer is full, this block stays interpreted */
+            code_used = CODE_BUFFER_SIZE;
+            return nullptr;
+        }
+
+        if (!executable) {
+            /* Nothing on these pages can run, keep them for later attempts */
+            code_used = start;
+            return nullptr;
+        }
+
+        return reinterpret_cast<native_block>(code_buffer + start);
+    }
+
+    template class JIT<std::uint32_t>;
+    template class JIT<std::uint64_t>;
+}
@@ -29,10 +29,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, ret_value);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. M.MULH: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, multiplier, rs2, multiplicand, rd, result);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULH: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, multiplier, rs2, multiplicand, rd, result);
     }
 
     template<>
@@ -53,10 +53,10 @@ namespace riscv_tlm {
         result = (result >> 32) & 0x00000000FFFFFFFF;
         this->regs->setValue(rd, static_cast<std::int32_t>(result));
 
-        this->logger->debug("{} ns. PC: 0x{:x}. M.MULHSU: x{:d} * x{:d} -> x{:d}({:d})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, rs2, rd, result);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULHSU: x{:d} * x{:d} -> x{:d}({:d})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, rs2, rd, result);
     }
 
     template<>
@@ -77,10 +77,10 @@ namespace riscv_tlm {
         ret_value = static_cast<std::int32_t>((result >> 32) & 0x00000000FFFFFFFF);
         this->regs->setValue(rd, ret_value);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. M.MULHU: x{:d} * x{:d} -> x{:d}({:d})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, rs2, rd, result);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULHU: x{:d} * x{:d} -> x{:d}({:d})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, rs2, rd, result);
     }
 
 
@@ -106,10 +106,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, result);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. M.MULH: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, multiplier, rs2, multiplicand, rd, result);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULH: x{:d}({:d}) * x{:d}({:d}) -> x{:d}({:d})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, multiplier, rs2, multiplicand, rd, result);
     }
 
     template<>
@@ -133,10 +133,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, result);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. M.MULHSU: x{:d} * x{:d} -> x{:d}({:d})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, rs2, rd, result);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULHSU: x{:d} * x{:d} -> x{:d}({:d})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, rs2, rd, result);
     }
 
     template<>
@@ -159,10 +159,10 @@ namespace riscv_tlm {
 
         this->regs->setValue(rd, result);
 
-        this->logger->debug("{} ns. PC: 0x{:x}. M.MULHU: x{:d} * x{:d} -> x{:d}({:d})",
-                            sc_core::sc_time_stamp().value(),
-                            this->regs->getPC(),
-                            rs1, rs2, rd, result);
+        LOG_INSTR(this->logger, "{} ns. PC: 0x{:x}. M.MULHU: x{:d} * x{:d} -> x{:d}({:d})",
+                                sc_core::sc_time_stamp().value(),
+                                this->regs->getPC(),
+                                rs1, rs2, rd, result);
     }
 
 }
\ No newline at end of file
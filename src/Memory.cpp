@@ -8,12 +8,49 @@
 
 #include "Memory.h"
 
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Checkpoint.h"
+
 namespace riscv_tlm {
 
+    namespace {
+        /**
+         * @brief Converts hex digits to a value, no validation (hex files are generated, not written)
+         * @param digits first digit
+         * @param count number of digits
+         * @return value
+         */
+        inline std::uint32_t hex_value(const char *digits, int count) {
+            std::uint32_t value = 0;
+
+            for (int i = 0; i < count; i++) {
+                char c = digits[i];
+                std::uint32_t nibble;
+
+                if (c <= '9') {
+                    nibble = c - '0';
+                } else {
+                    nibble = (c | 0x20) - 'a' + 10;
+                }
+                value = (value << 4) | (nibble & 0xF);
+            }
+            return value;
+        }
+    }
+
     SC_HAS_PROCESS(Memory);
 
-    Memory::Memory(sc_core::sc_module_name const &name, std::string const &filename) :
-            sc_module(name), socket("socket"), LATENCY(sc_core::SC_ZERO_TIME) {
+    Memory::Memory(sc_core::sc_module_name const &name, std::string const &filename,
+                   std::uint64_t size, std::uint64_t base) :
+            sc_module(name), socket("socket"), LATENCY(sc_core::SC_ZERO_TIME),
+            mem(nullptr), mem_size(size), mem_base(base) {
         // Register callbacks for incoming interface method calls
         socket.register_b_transport(this, &Memory::b_transport);
         socket.register_get_direct_mem_ptr(this, &Memory::get_direct_mem_ptr);
@@ -21,26 +58,49 @@ namespace riscv_tlm {
 
         dmi_allowed = false;
         program_counter = 0;
-        readHexFile(filename);
+        allocate();
+        if (ElfLoader::isElf(filename)) {
+            readElfFile(filename);
+        } else {
+            readHexFile(filename);
+        }
 
         logger = spdlog::get("my_logger");
         logger->debug("Using file {}", filename);
     }
 
-    Memory::Memory(sc_core::sc_module_name const &name) :
-            sc_module(name), socket("socket"), LATENCY(sc_core::SC_ZERO_TIME) {
+    Memory::Memory(sc_core::sc_module_name const &name, std::uint64_t size, std::uint64_t base) :
+            sc_module(name), socket("socket"), LATENCY(sc_core::SC_ZERO_TIME),
+            mem(nullptr), mem_size(size), mem_base(base) {
         socket.register_b_transport(this, &Memory::b_transport);
         socket.register_get_direct_mem_ptr(this, &Memory::get_direct_mem_ptr);
         socket.register_transport_dbg(this, &Memory::transport_dbg);
 
 	dmi_allowed = false;
         program_counter = 0;
+        allocate();
 
         logger = spdlog::get("my_logger");
         logger->debug("Memory instantiated wihtout file");
     }
 
-    Memory::~Memory() = default;
+    Memory::~Memory() {
+        if (mem != nullptr) {
+            munmap(mem, mem_size);
+            mem = nullptr;
+        }
+    }
+
+    void Memory::allocate() {
+        /* Anonymous pages read as zero and are committed on first touch */
+        void *buffer = mmap(nullptr, mem_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (buffer == MAP_FAILED) {
+            SC_REPORT_ERROR("Memory", "Cannot allocate memory");
+            return;
+        }
+        mem = static_cast<std::uint8_t *>(buffer);
+    }
 
     std::uint32_t Memory::getPCfromHEX() {
         return program_counter;
@@ -59,7 +119,7 @@ namespace riscv_tlm {
         // *********************************************
         // Generate the appropriate error response
         // *********************************************
-        if (adr >= sc_dt::uint64(Memory::SIZE)) {
+        if (!in_range(adr, len)) {
             trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
             return;
         }
@@ -67,16 +127,17 @@ namespace riscv_tlm {
             trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
             return;
         }
-        if (len > 4 || wid < len) {
+        /* Any length is fine (bursts), but streaming is not supported */
+        if (wid < len) {
             trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
             return;
         }
 
         // Obliged to implement read and write commands
         if (cmd == tlm::TLM_READ_COMMAND) {
-            std::copy_n(mem.cbegin() + adr, len, ptr);
+            std::copy_n(mem + (adr - mem_base), len, ptr);
         } else if (cmd == tlm::TLM_WRITE_COMMAND) {
-            std::copy_n(ptr, len, mem.begin() + adr);
+            std::copy_n(ptr, len, mem + (adr - mem_base));
         }
 
         // Illustrates that b_transport may block
@@ -107,9 +168,9 @@ namespace riscv_tlm {
         dmi_data.allow_read_write();
 
         // Set other details of DMI region
-        dmi_data.set_dmi_ptr(reinterpret_cast<unsigned char *>(&mem[0]));
-        dmi_data.set_start_address(0);
-        dmi_data.set_end_address(Memory::SIZE * 4 - 1);
+        dmi_data.set_dmi_ptr(mem);
+        dmi_data.set_start_address(mem_base);
+        dmi_data.set_end_address(mem_base + mem_size - 1);
         dmi_data.set_read_latency(LATENCY);
         dmi_data.set_write_latency(LATENCY);
 
@@ -122,86 +183,276 @@ namespace riscv_tlm {
         unsigned char *ptr = trans.get_data_ptr();
         unsigned int len = trans.get_data_length();
 
-        if (adr >= sc_dt::uint64(Memory::SIZE)) {
+        if (!in_range(adr, 1)) {
             trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
             return 0;
         }
 
         // Calculate the number of bytes to be actually copied
-        unsigned int num_bytes = (len < (Memory::SIZE - adr) * 4) ? len : (Memory::SIZE - adr) * 4;
+        std::uint64_t offset = adr - mem_base;
+        unsigned int num_bytes = (len < (mem_size - offset)) ? len : (mem_size - offset);
 
         if (cmd == tlm::TLM_READ_COMMAND) {
-            std::copy_n(mem.cbegin() + adr, len, ptr);
+            std::copy_n(mem + offset, num_bytes, ptr);
         } else if (cmd == tlm::TLM_WRITE_COMMAND) {
-            std::copy_n(ptr, len, mem.begin() + adr);
+            std::copy_n(ptr, num_bytes, mem + offset);
         }
 
         return num_bytes;
     }
 
+    void Memory::saveState(std::ostream &out) {
+        const std::uint64_t page_size = sysconf(_SC_PAGESIZE);
+        const std::uint64_t pages = (mem_size + page_size - 1) / page_size;
+        std::vector<unsigned char> resident(pages);
+        std::vector<std::uint64_t> saved;
+
+        /* Pages never touched are not resident and read as zero, skip them without reading.
+         * Pages mapped from a restored checkpoint drop out of the page cache, check them anyway */
+        if (mincore(mem, mem_size, resident.data()) != 0) {
+            std::fill(resident.begin(), resident.end(), 1);
+        }
+
+        for (std::uint64_t page = 0; page < pages; page++) {
+            bool restored = (page < restored_pages.size()) && restored_pages[page];
+            if (((resident[page] & 1) == 0) && !restored) {
+                continue;
+            }
+            const std::uint8_t *data = mem + page * page_size;
+            std::uint64_t len = std::min(page_size, mem_size - page * page_size);
+            if (std::any_of(data, data + len, [](std::uint8_t byte) { return byte != 0; })) {
+                saved.push_back(page);
+            }
+        }
+
+        Checkpoint::put<std::uint64_t>(out, mem_base);
+        Checkpoint::put<std::uint64_t>(out, mem_size);
+        Checkpoint::put<std::uint64_t>(out, page_size);
+        Checkpoint::put<std::uint64_t>(out, saved.size());
+
+        /* Page contents aligned to page size, so they can be mapped back */
+        std::uint64_t data_offset = static_cast<std::uint64_t>(out.tellp()) + (saved.size() + 1) * 8;
+        data_offset = (data_offset + page_size - 1) & ~(page_size - 1);
+        Checkpoint::put<std::uint64_t>(out, data_offset);
+        for (auto page : saved) {
+            Checkpoint::put<std::uint64_t>(out, page);
+        }
+
+        out.seekp(data_offset);
+        for (auto page : saved) {
+            std::vector<char> buffer(page_size, 0);
+            std::memcpy(buffer.data(), mem + page * page_size, std::min(page_size, mem_size - page * page_size));
+            out.write(buffer.data(), page_size);
+        }
+    }
+
+    bool Memory::restoreState(std::istream &in, const std::string &filename) {
+        const std::uint64_t page_size = sysconf(_SC_PAGESIZE);
+        auto base = Checkpoint::get<std::uint64_t>(in);
+        auto size = Checkpoint::get<std::uint64_t>(in);
+        auto saved_page_size = Checkpoint::get<std::uint64_t>(in);
+        auto count = Checkpoint::get<std::uint64_t>(in);
+        auto data_offset = Checkpoint::get<std::uint64_t>(in);
+
+        if (!in.good() || (saved_page_size != page_size)) {
+            return false;
+        }
+
+        std::vector<std::uint64_t> saved(count);
+        in.read(reinterpret_cast<char *>(saved.data()), count * sizeof(std::uint64_t));
+        if (!in.good()) {
+            return false;
+        }
+
+        /* Drop loaded program, memory starts all zeros again */
+        munmap(mem, mem_size);
+        mem = nullptr;
+        mem_base = base;
+        mem_size = size;
+        allocate();
+        if (mem == nullptr) {
+            return false;
+        }
+        restored_pages.assign((mem_size + page_size - 1) / page_size, false);
+
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        /* One mapping per run of consecutive pages, private so guest writes stay in RAM */
+        bool ok = true;
+        std::uint64_t i = 0;
+        while (ok && (i < count)) {
+            if (saved[i] * page_size >= mem_size) {
+                ok = false;
+                break;
+            }
+
+            std::uint64_t run = 1;
+            while ((i + run < count) && (saved[i + run] == saved[i] + run)) {
+                run++;
+            }
+
+            std::uint64_t len = std::min(run * page_size, mem_size - saved[i] * page_size);
+            void *map = mmap(mem + saved[i] * page_size, len, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_FIXED, fd, data_offset + i * page_size);
+            ok = (map != MAP_FAILED);
+            if (ok) {
+                std::fill_n(restored_pages.begin() + static_cast<std::ptrdiff_t>(saved[i]),
+                            (len + page_size - 1) / page_size, true);
+            }
+            i += run;
+        }
+        close(fd);
+
+        dmi_allowed = true;
+        return ok;
+    }
+
+    void Memory::readElfFile(std::string const &filename) {
+        ElfLoader elf(filename);
+
+        if (!elf.isValid()) {
+            SC_REPORT_ERROR("Memory", "ELF file error");
+            return;
+        }
+
+        const auto &segments = elf.getSegments();
+
+        /* Image linked out of the default memory, move the memory to it */
+        if ((mem_base == 0) && !segments.empty()) {
+            std::uint64_t lowest = segments.front().address;
+            for (const auto &segment : segments) {
+                lowest = std::min(lowest, segment.address);
+            }
+            if (!in_range(lowest, 1)) {
+                mem_base = lowest;
+                std::cout << "Memory base set to 0x" << std::hex
+                          << mem_base << std::dec << std::endl;
+            }
+        }
+
+        for (const auto &segment : segments) {
+            if (!in_range(segment.address, segment.mem_size)) {
+                std::stringstream error_msg;
+                error_msg << "ELF segment out of memory: 0x" << std::hex << segment.address;
+                SC_REPORT_ERROR("Memory", error_msg.str().c_str());
+                continue;
+            }
+            /* Memory is freshly mapped, bytes after file_size (.bss) are already zero */
+            std::memcpy(mem + (segment.address - mem_base), segment.data, segment.file_size);
+        }
+
+        program_counter = elf.getEntryPoint();
+        symbols = elf.getSymbols();
+        dmi_allowed = true;
+
+        std::cout << "ELF entry point 0x" << std::hex << program_counter << std::dec
+                  << ", " << symbols.size() << " symbols" << std::endl;
+    }
+
     void Memory::readHexFile(std::string const &filename) {
-        std::ifstream hexfile;
-        std::string line;
+        std::ifstream hexfile(filename, std::ios::binary);
+
+        if (!hexfile.is_open()) {
+            SC_REPORT_ERROR("Memory", "Open file error");
+            return;
+        }
+
+        /* Whole file at once, then a single pass without temporary strings */
+        std::stringstream buffer;
+        buffer << hexfile.rdbuf();
+        const std::string content = buffer.str();
+        hexfile.close();
+
         std::uint32_t memory_offset = 0;
+        std::uint32_t extended_address = 0;
+        bool data_loaded = false;
 
-        hexfile.open(filename);
-
-        if (hexfile.is_open()) {
-            std::uint32_t extended_address = 0;
-
-            while (getline(hexfile, line)) {
-                if (line[0] == ':') {
-                    if (line.substr(7, 2) == "00") {
-                        /* Data */
-                        int byte_count;
-                        std::uint32_t address;
-                        byte_count = std::stoi(line.substr(1, 2), nullptr, 16);
-                        address = std::stoi(line.substr(3, 4), nullptr, 16);
-                        address = address + extended_address + memory_offset;
-
-                        for (int i = 0; i < byte_count; i++) {
-                            mem[address + i] = stol(line.substr(9 + (i * 2), 2),
-                                                    nullptr, 16);
-                        }
-                    } else if (line.substr(7, 2) == "02") {
-                        /* Extended segment address */
-                        extended_address = stol(line.substr(9, 4), nullptr, 16)
-                                           * 16;
-                        std::cout << "02 extended address 0x" << std::hex
-                                  << extended_address << std::dec << std::endl;
-                    } else if (line.substr(7, 2) == "03") {
-                        /* Start segment address */
-                        std::uint32_t code_segment;
-                        code_segment = stol(line.substr(9, 4), nullptr, 16) * 16; /* ? */
-                        program_counter = stol(line.substr(13, 4), nullptr, 16);
-                        program_counter = program_counter + code_segment;
-                        std::cout << "03 PC set to 0x" << std::hex
-                                  << program_counter << std::dec << std::endl;
-                    } else if (line.substr(7, 2) == "04") {
-                        /* Start segment address */
-                        memory_offset = stol(line.substr(9, 4), nullptr, 16) << 16;
-                        extended_address = 0;
-                        std::cout << "04 address set to 0x" << std::hex
-                                  << extended_address << std::dec << std::endl;
-                        std::cout << "04 offset set to 0x" << std::hex
-                                  << memory_offset << std::dec << std::endl;
-                    } else if (line.substr(7, 2) == "05") {
-                        program_counter = stol(line.substr(9, 8), nullptr, 16);
-                        std::cout << "05 PC set to 0x" << std::hex
-                                  << program_counter << std::dec << std::endl;
-                    }
-                }
+        const char *line = content.data();
+        const char *end = line + content.size();
+
+        for (const char *eol; line < end; line = eol + 1) {
+            eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+            if (eol == nullptr) {
+                eol = end;
             }
-            hexfile.close();
 
-            if (memory_offset != 0) {
-                dmi_allowed = false;
-            } else {
-                dmi_allowed = true;
+            /* ':' + count + address + type, at least */
+            if ((eol - line < 9) || (line[0] != ':')) {
+                continue;
             }
 
-        } else {
-            SC_REPORT_ERROR("Memory", "Open file error");
+            unsigned int byte_count = hex_value(line + 1, 2);
+            unsigned int record_type = hex_value(line + 7, 2);
+            const char *data = line + 9;
+
+            if (eol - data < static_cast<long>(byte_count * 2)) {
+                SC_REPORT_ERROR("Memory", "Hex file truncated record");
+                break;
+            }
+
+            switch (record_type) {
+                case 0x00: {
+                    /* Data */
+                    std::uint32_t address = hex_value(line + 3, 4) + extended_address + memory_offset;
+
+                    if (!in_range(address, byte_count)) {
+                        std::stringstream error_msg;
+                        error_msg << "Hex file data out of memory: 0x" << std::hex << address;
+                        SC_REPORT_ERROR("Memory", error_msg.str().c_str());
+                        break;
+                    }
+
+                    std::uint8_t *dst = mem + (address - mem_base);
+                    for (unsigned int i = 0; i < byte_count; i++) {
+                        dst[i] = hex_value(data + (i * 2), 2);
+                    }
+                    data_loaded = true;
+                    break;
+                }
+                case 0x02:
+                    /* Extended segment address */
+                    extended_address = hex_value(data, 4) * 16;
+                    std::cout << "02 extended address 0x" << std::hex
+                              << extended_address << std::dec << std::endl;
+                    break;
+                case 0x03: {
+                    /* Start segment address */
+                    std::uint32_t code_segment = hex_value(data, 4) * 16; /* ? */
+                    program_counter = hex_value(data + 4, 4) + code_segment;
+                    std::cout << "03 PC set to 0x" << std::hex
+                              << program_counter << std::dec << std::endl;
+                    break;
+                }
+                case 0x04:
+                    /* Extended linear address */
+                    memory_offset = hex_value(data, 4) << 16;
+                    extended_address = 0;
+                    std::cout << "04 address set to 0x" << std::hex
+                              << extended_address << std::dec << std::endl;
+                    std::cout << "04 offset set to 0x" << std::hex
+                              << memory_offset << std::dec << std::endl;
+
+                    /* Image linked out of the default memory, move the memory to it */
+                    if ((mem_base == 0) && !data_loaded && !in_range(memory_offset, 1)) {
+                        mem_base = memory_offset;
+                        std::cout << "Memory base set to 0x" << std::hex
+                                  << mem_base << std::dec << std::endl;
+                    }
+                    break;
+                case 0x05:
+                    /* Start linear address */
+                    program_counter = hex_value(data, 8);
+                    std::cout << "05 PC set to 0x" << std::hex
+                              << program_counter << std::dec << std::endl;
+                    break;
+                default:
+                    break;
+            }
         }
+
+        dmi_allowed = true;
     }
 }
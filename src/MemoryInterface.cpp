@@ -7,40 +7,49 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "MemoryInterface.h"
+#include "DecodeCache.h"
+#include "FastScheduler.h"
+#include "InstrLog.h"
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
 namespace riscv_tlm {
 
     MemoryInterface::MemoryInterface() :
-            data_bus("data_bus") {}
+            data_bus("data_bus") {
+        data_bus.register_invalidate_direct_mem_ptr(this, &MemoryInterface::invalidate_direct_mem_ptr);
+    }
 
 /**
  * Access data memory to get data
  * @param  addr address to access to
- * @param size size of the data to read in bytes
+ * @param size size of the data to read in bytes (1, 2, 4 or 8)
  * @return data value read
  */
-    std::uint32_t MemoryInterface::readDataMem(std::uint64_t addr, int size) {
-        std::uint32_t data;
-        tlm::tlm_generic_payload trans;
-        sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+    std::uint64_t MemoryInterface::readDataMem(std::uint64_t addr, int size) {
+        std::uint64_t data = 0;
 
-        trans.set_command(tlm::TLM_READ_COMMAND);
-        trans.set_data_ptr(reinterpret_cast<unsigned char *>(&data));
-        trans.set_data_length(size);
-        trans.set_streaming_width(4); // = data_length to indicate no streaming
-        trans.set_byte_enable_ptr(nullptr); // 0 indicates unused
-        trans.set_dmi_allowed(false); // Mandatory initial value
-        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
-        trans.set_address(addr);
+        if (replay_mode == REPLAY_CHECK) {
+            return replay({addr, 0, size, false});
+        }
 
-        data_bus->b_transport(trans, delay);
+        /* Plain RAM, no need to go through the bus */
+        unsigned char *dmi_ptr = dmi_pointer(addr, size, false);
+        if (dmi_ptr != nullptr) {
+            std::memcpy(&data, dmi_ptr, size);
+        } else if (!bus_access(tlm::TLM_READ_COMMAND, addr, reinterpret_cast<unsigned char *>(&data), size, true)) {
+            bus_error(tlm::TLM_READ_COMMAND, addr);
+        }
 
-        if (trans.is_response_error()) {
-            std::stringstream error_msg;
-            error_msg << "Read memory: 0x" << std::hex << addr;
-            SC_REPORT_ERROR("Memory", error_msg.str().c_str());
+        if (replay_mode == REPLAY_RECORD) {
+            replay_log.push_back({addr, data, size, false});
+        }
+
+        if constexpr (InstrLog::enabled) {
+            if (instr_log != nullptr) {
+                instr_log->noteMem(addr, data, size, false);
+            }
         }
 
         return data;
@@ -51,27 +60,145 @@ namespace riscv_tlm {
  * @brief
  * @param addr addr address to access to
  * @param data data to write
- * @param size size of the data to write in bytes
+ * @param size size of the data to write in bytes (1, 2, 4 or 8)
  */
-    void MemoryInterface::writeDataMem(std::uint64_t addr, std::uint32_t data, int size) {
+    void MemoryInterface::writeDataMem(std::uint64_t addr, std::uint64_t data, int size) {
+        if (replay_mode == REPLAY_CHECK) {
+            replay({addr, data, size, true});
+            return;
+        }
+
+        unsigned char *dmi_ptr = dmi_pointer(addr, size, true);
+        if (dmi_ptr != nullptr) {
+            std::memcpy(dmi_ptr, &data, size);
+        } else if (!bus_access(tlm::TLM_WRITE_COMMAND, addr, reinterpret_cast<unsigned char *>(&data), size, true)) {
+            bus_error(tlm::TLM_WRITE_COMMAND, addr);
+        }
+
+        if (replay_mode == REPLAY_RECORD) {
+            replay_log.push_back({addr, data, size, true});
+        }
+
+        /* Self-modifying code */
+        if (decode_cache != nullptr) {
+            decode_cache->invalidate(addr, size);
+        }
+
+        if constexpr (InstrLog::enabled) {
+            if (instr_log != nullptr) {
+                instr_log->noteMem(addr, data, size, true);
+            }
+        }
+    }
+
+    bool MemoryInterface::readDataBurst(std::uint64_t addr, unsigned char *data, unsigned int len) {
+        unsigned char *dmi_ptr = dmi_pointer(addr, len, false);
+        if (dmi_ptr != nullptr) {
+            std::memcpy(data, dmi_ptr, len);
+            return true;
+        }
+
+        return bus_access(tlm::TLM_READ_COMMAND, addr, data, len, false);
+    }
+
+    bool MemoryInterface::writeDataBurst(std::uint64_t addr, const unsigned char *data, unsigned int len) {
+        bool ok = true;
+
+        unsigned char *dmi_ptr = dmi_pointer(addr, len, true);
+        if (dmi_ptr != nullptr) {
+            std::memcpy(dmi_ptr, data, len);
+        } else {
+            /* Payload data pointer is not const, target only reads from it on writes */
+            ok = bus_access(tlm::TLM_WRITE_COMMAND, addr, const_cast<unsigned char *>(data), len, false);
+        }
+
+        /* Self-modifying code */
+        if (ok && (decode_cache != nullptr)) {
+            decode_cache->invalidate(addr, len);
+        }
+        return ok;
+    }
+
+    std::uint64_t MemoryInterface::replay(const replay_access &access) {
+        if (replay_pos < replay_log.size()) {
+            const replay_access &recorded = replay_log[replay_pos];
+            if ((recorded.addr == access.addr) && (recorded.size == access.size) &&
+                (recorded.write == access.write) && (!access.write || (recorded.data == access.data))) {
+                replay_pos++;
+                return recorded.data;
+            }
+        }
+
+        replay_diverged = true;
+        return 0;
+    }
+
+    bool MemoryInterface::bus_access(tlm::tlm_command cmd, std::uint64_t addr, unsigned char *data,
+                                     unsigned int len, bool timed) {
         tlm::tlm_generic_payload trans;
         sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
 
-        trans.set_command(tlm::TLM_WRITE_COMMAND);
-        trans.set_data_ptr(reinterpret_cast<unsigned char *>(&data));
-        trans.set_data_length(size);
-        trans.set_streaming_width(4); // = data_length to indicate no streaming
+        trans.set_command(cmd);
+        trans.set_data_ptr(data);
+        trans.set_data_length(len);
+        trans.set_streaming_width(len); // = data_length to indicate no streaming
         trans.set_byte_enable_ptr(nullptr); // 0 indicates unused
         trans.set_dmi_allowed(false); // Mandatory initial value
         trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
         trans.set_address(addr);
 
+        /* Not plain RAM (no DMI), device may depend on current time */
+        if (timed && (m_qk != nullptr)) {
+            m_qk->sync();
+        }
+
         data_bus->b_transport(trans, delay);
 
+        /* Time annotated by the device (e.g. Timer skipping a polling loop) */
+        if (timed && (delay != sc_core::SC_ZERO_TIME)) {
+            if (m_qk != nullptr) {
+                m_qk->inc(delay);
+            } else if (FastScheduler::getInstance()->isEnabled()) {
+                FastScheduler::getInstance()->advance(delay.value());
+            } else {
+                pending_delay += delay;
+            }
+        }
+
         if (trans.is_response_error()) {
-            std::stringstream error_msg;
-            error_msg << "Write memory: 0x" << std::hex << addr;
-            SC_REPORT_ERROR("Memory", error_msg.str().c_str());
+            return false;
+        }
+
+        if (trans.is_dmi_allowed()) {
+            request_dmi(trans);
+        }
+        return true;
+    }
+
+    void MemoryInterface::bus_error(tlm::tlm_command cmd, std::uint64_t addr) {
+        std::stringstream error_msg;
+        error_msg << ((cmd == tlm::TLM_READ_COMMAND) ? "Read" : "Write")
+                  << " memory: 0x" << std::hex << addr;
+        SC_REPORT_ERROR("Memory", error_msg.str().c_str());
+    }
+
+    void MemoryInterface::request_dmi(tlm::tlm_generic_payload &trans) {
+        tlm::tlm_dmi dmi_data;
+
+        if (data_bus->get_direct_mem_ptr(trans, dmi_data)) {
+            dmi_regions.push_back(dmi_data);
+        }
+    }
+
+    void MemoryInterface::invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end) {
+        auto it = dmi_regions.begin();
+
+        while (it != dmi_regions.end()) {
+            if ((it->get_start_address() <= end) && (it->get_end_address() >= start)) {
+                it = dmi_regions.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
-}
\ No newline at end of file
+}
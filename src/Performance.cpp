@@ -8,13 +8,7 @@
 
 #include "Performance.h"
 
-Performance* Performance::getInstance() {
-	if (instance == nullptr) {
-		instance = new Performance();
-	}
-
-	return instance;
-}
+#include <iomanip>
 
 Performance::Performance() {
 	data_memory_read = 0;
@@ -24,10 +18,37 @@ Performance::Performance() {
 	register_read = 0;
 	register_write = 0;
 	instructions_executed = 0;
+	compressed_instructions = 0;
+	full_instructions = 0;
+	loads = 0;
+	stores = 0;
+	branches_taken = 0;
+	branches_not_taken = 0;
+	csr_ops = 0;
+	amos = 0;
+	decode_cache_hit = 0;
+	decode_cache_miss = 0;
+	blocks_translated = 0;
+	blocks_executed = 0;
+	jit_blocks_compiled = 0;
+	jit_blocks_executed = 0;
+	fused_pairs = 0;
+	block_link_hit = 0;
+	block_link_miss = 0;
+	indirect_hit = 0;
+	indirect_miss = 0;
+	return_hit = 0;
+	return_miss = 0;
 }
 
 void Performance::dump() const {
     std::cout << "************************************" << std::endl;
+	if (!enabled) {
+		std::cout << std::dec << "# instructions executed: " << instructions_executed << std::endl;
+		std::cout << "************************************" << std::endl;
+		return;
+	}
+
 	std::cout << std::dec << "# data memory reads: " << data_memory_read << std::endl;
 	std::cout << "# data memory writes: " << data_memory_write << std::endl;
 	std::cout << "# code memory reads: " << code_memory_read << std::endl;
@@ -35,7 +56,75 @@ void Performance::dump() const {
 	std::cout << "# registers read: " << register_read << std::endl;
 	std::cout << "# registers write: " << register_write << std::endl;
 	std::cout << "# instructions executed: " << instructions_executed << std::endl;
+	std::cout << "# compressed / full instructions: " << compressed_instructions
+			<< " / " << full_instructions << std::endl;
+	std::cout << "# loads: " << loads << std::endl;
+	std::cout << "# stores: " << stores << std::endl;
+	std::cout << "# branches taken / not taken: " << branches_taken
+			<< " / " << branches_not_taken << std::endl;
+	std::cout << "# CSR instructions: " << csr_ops << std::endl;
+	std::cout << "# AMO instructions: " << amos << std::endl;
+
+	uint_fast64_t decode_lookups = decode_cache_hit + decode_cache_miss;
+	if (decode_lookups != 0) {
+		std::cout << "# decode cache hits: " << decode_cache_hit << " ("
+				<< std::fixed << std::setprecision(2)
+				<< (100.0 * decode_cache_hit) / decode_lookups << "%)"
+				<< std::defaultfloat << std::endl;
+	}
+	if (blocks_executed != 0) {
+		std::cout << "# blocks translated: " << blocks_translated << std::endl;
+		std::cout << "# blocks executed: " << blocks_executed << std::endl;
+		std::cout << "# block links hit / miss: " << block_link_hit
+				<< " / " << block_link_miss << std::endl;
+		std::cout << "# indirect target cache hit / miss: " << indirect_hit
+				<< " / " << indirect_miss << std::endl;
+		std::cout << "# return address stack hit / miss: " << return_hit
+				<< " / " << return_miss << std::endl;
+	}
+	if (jit_blocks_compiled != 0) {
+		std::cout << "# JIT blocks compiled: " << jit_blocks_compiled << std::endl;
+		std::cout << "# JIT blocks executed: " << jit_blocks_executed << std::endl;
+	}
+	if (fused_pairs != 0) {
+		std::cout << "# fused pairs executed: " << fused_pairs << std::endl;
+	}
     std::cout << "************************************" << std::endl;
 }
 
-Performance *Performance::instance = nullptr;
+void Performance::dumpJSON(std::ostream &out) const {
+	out << std::dec << "{\n";
+	out << "  \"stats_enabled\": " << (enabled ? "true" : "false") << ",\n";
+	out << "  \"instructions_executed\": " << instructions_executed;
+	if (enabled) {
+		out << ",\n";
+		out << "  \"data_memory_reads\": " << data_memory_read << ",\n";
+		out << "  \"data_memory_writes\": " << data_memory_write << ",\n";
+		out << "  \"code_memory_reads\": " << code_memory_read << ",\n";
+		out << "  \"code_memory_writes\": " << code_memory_write << ",\n";
+		out << "  \"register_reads\": " << register_read << ",\n";
+		out << "  \"register_writes\": " << register_write << ",\n";
+		out << "  \"compressed_instructions\": " << compressed_instructions << ",\n";
+		out << "  \"full_instructions\": " << full_instructions << ",\n";
+		out << "  \"loads\": " << loads << ",\n";
+		out << "  \"stores\": " << stores << ",\n";
+		out << "  \"branches_taken\": " << branches_taken << ",\n";
+		out << "  \"branches_not_taken\": " << branches_not_taken << ",\n";
+		out << "  \"csr_instructions\": " << csr_ops << ",\n";
+		out << "  \"amo_instructions\": " << amos << ",\n";
+		out << "  \"decode_cache_hits\": " << decode_cache_hit << ",\n";
+		out << "  \"decode_cache_misses\": " << decode_cache_miss << ",\n";
+		out << "  \"blocks_translated\": " << blocks_translated << ",\n";
+		out << "  \"blocks_executed\": " << blocks_executed << ",\n";
+		out << "  \"jit_blocks_compiled\": " << jit_blocks_compiled << ",\n";
+		out << "  \"jit_blocks_executed\": " << jit_blocks_executed << ",\n";
+		out << "  \"fused_pairs\": " << fused_pairs << ",\n";
+		out << "  \"block_link_hits\": " << block_link_hit << ",\n";
+		out << "  \"block_link_misses\": " << block_link_miss << ",\n";
+		out << "  \"indirect_hits\": " << indirect_hit << ",\n";
+		out << "  \"indirect_misses\": " << indirect_miss << ",\n";
+		out << "  \"return_hits\": " << return_hit << ",\n";
+		out << "  \"return_misses\": " << return_miss;
+	}
+	out << "\n}\n";
+}
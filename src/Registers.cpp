@@ -100,7 +100,8 @@ namespace riscv_tlm {
 
     template<>
     void Registers<std::uint64_t>::initCSR() {
-        CSR[CSR_MISA] = (((std::uint64_t) 0x02) << 30) | MISA_M_EXTENSION | MISA_C_EXTENSION
+        /* MXL = 2 (64 bits) lives at the top of misa */
+        CSR[CSR_MISA] = (((std::uint64_t) 0x02) << 62) | MISA_M_EXTENSION | MISA_C_EXTENSION
                         | MISA_A_EXTENSION | MISA_I_BASE;
         CSR[CSR_MSTATUS] = MISA_MXL;
     }
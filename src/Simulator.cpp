@@ -11,14 +11,20 @@
 
 #include <csignal>
 #include <unistd.h>
+#include <getopt.h>
 #include <chrono>
 #include <cstdint>
+#include <thread>
+#include <vector>
 
 #include "CPU.h"
 #include "BusCtrl.h"
 #include "Trace.h"
 #include "Timer.h"
 #include "Debug.h"
+#include "Checkpoint.h"
+#include "FastScheduler.h"
+#include "Sweep.h"
 
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/basic_file_sink.h"
@@ -30,7 +36,31 @@ bool mem_dump = false;
 uint32_t dump_addr_st = 0;
 uint32_t dump_addr_end = 0;
 
-riscv_tlm::cpu_types_t cpu_type_opt = riscv_tlm::RV32;
+riscv_tlm::cpu_types_t cpu_type_opt = riscv_tlm::RV32IMAC;
+riscv_tlm::exec_mode_t exec_mode_opt = riscv_tlm::INTERPRETER;
+bool jit_opt = false;
+bool jit_check_opt = false;
+bool fuse_opt = false;
+std::uint64_t mem_size_opt = riscv_tlm::Memory::DEFAULT_SIZE;
+std::uint64_t mem_base_opt = 0;
+std::uint64_t quantum_opt = 0;
+std::string checkpoint_save_opt;
+std::uint64_t checkpoint_time_opt = 0;
+std::string checkpoint_restore_opt;
+unsigned int variants_opt = 0;
+unsigned int fork_jobs_opt = 0;
+std::uint64_t fork_time_opt = 0;
+std::uint64_t variant_addr_opt = 0;
+bool fast_opt = false;
+std::uint64_t spin_skip_opt = 0;
+unsigned int cpi_opt = 1;
+std::string stats_opt;
+std::string trace_bin_opt;
+riscv_tlm::trace::codec_t trace_codec_opt = riscv_tlm::trace::CODEC_NONE;
+
+riscv_tlm::Sweep *sweep = nullptr;
+std::uint64_t fork_instructions = 0;
+std::uint64_t signature_hash = 0;
 
 /**
  * @class Simulator
@@ -47,39 +77,90 @@ public:
     riscv_tlm::peripherals::Trace *trace;
     riscv_tlm::peripherals::Timer *timer;
 
+	SC_HAS_PROCESS(Simulator);
+
 	explicit Simulator(sc_core::sc_module_name const &name, riscv_tlm::cpu_types_t cpu_type_m): sc_module(name) {
 		std::uint32_t start_PC;
 
-		MainMemory = new riscv_tlm::Memory("Main_Memory", filename);
+		if (filename.empty()) {
+			/* Restoring a checkpoint, no program to load */
+			MainMemory = new riscv_tlm::Memory("Main_Memory", mem_size_opt, mem_base_opt);
+		} else {
+			MainMemory = new riscv_tlm::Memory("Main_Memory", filename, mem_size_opt, mem_base_opt);
+		}
 		start_PC = MainMemory->getPCfromHEX();
 
         cpu_type = cpu_type_m;
 
-        if (cpu_type == riscv_tlm::RV32) {
-            cpu = new riscv_tlm::CPURV32("cpu", start_PC, debug_session);
-        } else {
-            cpu = new riscv_tlm::CPURV64("cpu", start_PC, debug_session);
+        /* Debugger and fast mode drive the CPU themselves, no CPU_thread */
+        switch (cpu_type) {
+            case riscv_tlm::RV32I:
+                cpu = new riscv_tlm::CPURV32I("cpu", start_PC, debug_session || fast_opt);
+                break;
+            case riscv_tlm::RV64IMAC:
+                cpu = new riscv_tlm::CPURV64IMAC("cpu", start_PC, debug_session || fast_opt);
+                break;
+            default:
+                cpu = new riscv_tlm::CPURV32IMAC("cpu", start_PC, debug_session || fast_opt);
+                break;
+        }
+        cpu->setExecMode(exec_mode_opt);
+        cpu->setFusion(fuse_opt);
+        if (!fast_opt) {
+            cpu->setQuantum(sc_core::sc_time(static_cast<double>(quantum_opt), sc_core::SC_NS));
+        }
+        if (jit_opt) {
+            cpu->enableJIT(jit_check_opt);
+        }
+        cpu->setCyclesPerInstruction(cpi_opt);
+        if (!trace_bin_opt.empty() && !cpu->setInstrLog(trace_bin_opt, trace_codec_opt)) {
+            std::cerr << "Cannot write instruction trace " << trace_bin_opt
+                      << " (needs a build with ENABLE_INSTR_LOG)" << std::endl;
         }
 
 		Bus = new riscv_tlm::BusCtrl("BusCtrl");
 		trace = new riscv_tlm::peripherals::Trace("Trace");
 		timer = new riscv_tlm::peripherals::Timer("Timer");
+		timer->setSpinSkip(spin_skip_opt, cpu->getPerformance());
 
 		cpu->instr_bus.bind(Bus->cpu_instr_socket);
 		cpu->mem_intf->data_bus.bind(Bus->cpu_data_socket);
 
-		Bus->memory_socket.bind(MainMemory->socket);
-		Bus->trace_socket.bind(trace->socket);
-		Bus->timer_socket.bind(timer->socket);
-
 		timer->irq_line.bind(cpu->irq_line_socket);
 
+		if (!checkpoint_restore_opt.empty()) {
+			if (!riscv_tlm::Checkpoint::restore(checkpoint_restore_opt, cpu, MainMemory, timer)) {
+				SC_REPORT_ERROR("Simulator", "Cannot restore checkpoint");
+			}
+		}
+
+		/* After restoring, checkpoint may move the memory */
+		Bus->register_target("memory", MainMemory->socket, MainMemory->getBase(), MainMemory->getSize(), true);
+		Bus->register_target("trace", trace->socket, TRACE_MEMORY_ADDRESS, 4, false);
+		Bus->register_target("timer", timer->socket, TIMER_MEMORY_ADDRESS_LO, 16, false);
+
+		if (fast_opt) {
+			auto *scheduler = riscv_tlm::FastScheduler::getInstance();
+
+			if (!checkpoint_save_opt.empty()) {
+				scheduler->schedule(checkpoint_time_opt, [this]() { save_checkpoint(); });
+			}
+
+			if (variants_opt != 0) {
+				scheduler->schedule(fork_time_opt, [this]() { fork_variants(); });
+			}
+		} else {
+			if (!checkpoint_save_opt.empty()) {
+				SC_THREAD(checkpoint_thread);
+			}
+
+			if (variants_opt != 0) {
+				SC_THREAD(fork_thread);
+			}
+		}
+
 		if (debug_session) {
-            if (cpu_type == riscv_tlm::RV32) {
-                riscv_tlm::Debug Debug(dynamic_cast<riscv_tlm::CPURV32*>(cpu), MainMemory);
-            } else {
-                riscv_tlm::Debug Debug(dynamic_cast<riscv_tlm::CPURV64*>(cpu), MainMemory);
-            }
+            riscv_tlm::Debug Debug(cpu);
 		}
 	}
 
@@ -87,6 +168,14 @@ public:
 	    if (mem_dump) {
             MemoryDump();
         }
+		if (!stats_opt.empty()) {
+			std::string stats_name = stats_opt;
+			if ((sweep != nullptr) && sweep->isChild()) {
+				stats_name += ".variant" + std::to_string(sweep->getVariant());
+			}
+			std::ofstream stats_file(stats_name);
+			cpu->getPerformance()->dumpJSON(stats_file);
+		}
 		delete MainMemory;
 		delete cpu;
 		delete Bus;
@@ -94,10 +183,101 @@ public:
 		delete timer;
 	}
 
+    /**
+     * @brief Runs the simulation without the SystemC scheduler
+     *
+     * CPU is called in a host loop, time is the instruction count times the
+     * instruction time and timed events come from the FastScheduler. The
+     * loop ends when some module calls sc_stop().
+     */
+    void run_fast() {
+        auto *scheduler = riscv_tlm::FastScheduler::getInstance();
+        std::uint64_t instruction_time = cpu->getInstructionTime().value();
+        bool irq_taken;
+
+        /* Ends elaboration and runs the first delta cycle of peripheral threads */
+        sc_core::sc_start(sc_core::SC_ZERO_TIME);
+
+        while (sc_core::sc_get_status() != sc_core::SC_STOPPED) {
+            unsigned int executed = cpu->CPU_execute(&irq_taken);
+            scheduler->advance(instruction_time * executed);
+        }
+    }
+
 private:
+    /**
+     * @brief Saves a checkpoint at the requested time. SystemC threads are
+     * not preempted, so the CPU is always between instructions here.
+     */
+    void checkpoint_thread() {
+        wait(sc_core::sc_time(static_cast<double>(checkpoint_time_opt), sc_core::SC_NS));
+        save_checkpoint();
+    }
+
+    void save_checkpoint() {
+        riscv_tlm::Checkpoint::save(checkpoint_save_opt, cpu, MainMemory, timer);
+    }
+
+    /**
+     * @brief Forks all variants at the requested time. Children go on with
+     * the simulation, the parent waits for them and stops.
+     */
+    void fork_thread() {
+        wait(sc_core::sc_time(static_cast<double>(fork_time_opt), sc_core::SC_NS));
+        fork_variants();
+    }
+
+    void fork_variants() {
+        fork_instructions = cpu->getPerformance()->getInstructions();
+        /* The trace writer thread does not survive fork(), finish the
+         * common part here and give each variant its own file */
+        if (!trace_bin_opt.empty()) {
+            cpu->setInstrLog("", trace_codec_opt);
+        }
+        int variant = sweep->fork_variants();
+
+        if (variant < 0) {
+            /* Parent memory is the common state, not a result */
+            mem_dump = false;
+            sc_core::sc_stop();
+            return;
+        }
+
+        if (!trace_bin_opt.empty()) {
+            std::string trace_name = trace_bin_opt + ".variant" + std::to_string(variant);
+            if (!cpu->setInstrLog(trace_name, trace_codec_opt)) {
+                std::cerr << "Cannot write instruction trace " << trace_name << std::endl;
+            }
+        }
+
+        /* Let the program know which variant it is */
+        if (variant_addr_opt != 0) {
+            std::uint32_t value = variant;
+            tlm::tlm_generic_payload trans;
+
+            trans.set_command(tlm::TLM_WRITE_COMMAND);
+            trans.set_address(variant_addr_opt);
+            trans.set_data_ptr(reinterpret_cast<unsigned char *>(&value));
+            trans.set_data_length(4);
+            MainMemory->transport_dbg(trans);
+        }
+    }
+
     void MemoryDump() const {
 	    std::cout << "********** MEMORY DUMP ***********\n";
 
+        /* riscv-arch-test signature symbols, if program is an ELF file */
+        std::uint64_t symbol_addr;
+        const riscv_tlm::SymbolTable &symbols = MainMemory->getSymbols();
+
+        if ((dump_addr_st == 0) && symbols.getAddress("begin_signature", &symbol_addr)) {
+            dump_addr_st = symbol_addr;
+        }
+
+        if ((dump_addr_end == 0) && symbols.getAddress("end_signature", &symbol_addr)) {
+            dump_addr_end = symbol_addr;
+        }
+
         if (dump_addr_st == 0) {
             dump_addr_st = cpu->getStartDumpAddress();
         }
@@ -107,32 +287,34 @@ private:
         }
 
         std::cout << "from 0x" << std::hex << dump_addr_st << " to 0x" << dump_addr_end << "\n";
-        tlm::tlm_generic_payload trans;
-        sc_core::sc_time delay;
-        std::uint32_t data[4];
-
-        trans.set_command(tlm::TLM_READ_COMMAND);
-        trans.set_data_ptr(reinterpret_cast<unsigned char*>(data));
-        trans.set_data_length(4);
-        trans.set_streaming_width(4); // = data_length to indicate no streaming
-        trans.set_byte_enable_ptr(nullptr); // 0 indicates unused
-        trans.set_dmi_allowed(false); // Mandatory initial value
-        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        /* Whole signature area in a single burst */
+        std::size_t words = (dump_addr_end > dump_addr_st) ? (dump_addr_end - dump_addr_st + 3) / 4 : 0;
+        std::vector<std::uint32_t> data(words);
+        if ((words != 0) &&
+            !cpu->mem_intf->readDataBurst(dump_addr_st, reinterpret_cast<unsigned char*>(data.data()), words * 4)) {
+            std::cerr << "Cannot read signature area" << std::endl;
+        }
+
+        /* FNV-1a, lets the sweep parent compare variant results */
+        signature_hash = 0xcbf29ce484222325ULL;
+        for (auto word : data) {
+            signature_hash = (signature_hash ^ word) * 0x100000001b3ULL;
+        }
 
         /* Filename in format name.elf.hex should be name.signature_output */
         std::string base_filename = filename.substr(filename.find_last_of("/\\") + 1);
         std::string base_name = base_filename.substr(0, base_filename.find('.'));
+        if ((sweep != nullptr) && sweep->isChild()) {
+            base_name += ".variant" + std::to_string(sweep->getVariant());
+        }
         std::string local_name = base_name + ".signature.output";
         std::cout << "filename is " << local_name << '\n';
 
         std::ofstream signature_file;
         signature_file.open(local_name);
 
-        for(unsigned int i = dump_addr_st; i < dump_addr_end; i = i+4) {
-            //trans.set_address(dump_addr + (i*4));
-            trans.set_address(i);
-            MainMemory->b_transport(trans, delay);
-            signature_file << std::hex << std::setfill('0') << std::setw(8) << data[0] <<  "\n";
+        for (auto word : data) {
+            signature_file << std::hex << std::setfill('0') << std::setw(8) << word <<  "\n";
         }
 
         signature_file.close();
@@ -152,15 +334,67 @@ void intHandler(int dummy) {
 	exit(-1);
 }
 
+/**
+ * @brief Parse a size argument, accepts K, M and G suffixes
+ * @param arg size as given by the user, decimal or hex (0x prefix)
+ * @return size in bytes
+ */
+std::uint64_t parse_size(const char *arg) {
+	char *end;
+	std::uint64_t value = std::strtoull(arg, &end, 0);
+
+	switch (*end) {
+	case 'k':
+	case 'K':
+		value <<= 10;
+		break;
+	case 'm':
+	case 'M':
+		value <<= 20;
+		break;
+	case 'g':
+	case 'G':
+		value <<= 30;
+		break;
+	default:
+		break;
+	}
+	return value;
+}
+
 void process_arguments(int argc, char *argv[]) {
 
 	int c;
 	long int debug_level;
 
+	static struct option long_options[] = {
+		{"mode", required_argument, nullptr, 'M'},
+		{"jit", no_argument, nullptr, 'J'},
+		{"jit-check", no_argument, nullptr, 'K'},
+		{"fuse", no_argument, nullptr, 'G'},
+		{"mem-size", required_argument, nullptr, 'S'},
+		{"mem-base", required_argument, nullptr, 'A'},
+		{"checkpoint-save", required_argument, nullptr, 'C'},
+		{"checkpoint-time", required_argument, nullptr, 'N'},
+		{"checkpoint-restore", required_argument, nullptr, 'U'},
+		{"quantum", required_argument, nullptr, 'Q'},
+		{"variants", required_argument, nullptr, 'V'},
+		{"fork-time", required_argument, nullptr, 'F'},
+		{"fork-jobs", required_argument, nullptr, 'j'},
+		{"variant-addr", required_argument, nullptr, 'a'},
+		{"fast", no_argument, nullptr, 'X'},
+		{"spin-skip", required_argument, nullptr, 'P'},
+		{"cpi", required_argument, nullptr, 'I'},
+		{"stats", required_argument, nullptr, 'O'},
+		{"trace-bin", required_argument, nullptr, 'W'},
+		{"trace-compress", required_argument, nullptr, 'Z'},
+		{nullptr, 0, nullptr, 0}
+	};
+
 	debug_session = false;
-    cpu_type_opt = riscv_tlm::RV32;
+    cpu_type_opt = riscv_tlm::RV32IMAC;
 
-	while ((c = getopt(argc, argv, "DTE:B:L:f:R:?")) != -1) {
+	while ((c = getopt_long(argc, argv, "DTE:B:L:f:R:M:?", long_options, nullptr)) != -1) {
 		switch (c) {
 		case 'D':
 			debug_session = true;
@@ -208,14 +442,90 @@ void process_arguments(int argc, char *argv[]) {
 			filename = std::string(optarg);
 			break;
         case 'R':
-            if (strcmp(optarg, "32") == 0) {
-                cpu_type_opt = riscv_tlm::RV32;
+            if ((strcmp(optarg, "32") == 0) || (strcmp(optarg, "rv32imac") == 0)) {
+                cpu_type_opt = riscv_tlm::RV32IMAC;
+            } else if (strcmp(optarg, "rv32i") == 0) {
+                cpu_type_opt = riscv_tlm::RV32I;
+            } else {
+                cpu_type_opt = riscv_tlm::RV64IMAC;
+            }
+            break;
+        case 'M':
+            if (strcmp(optarg, "block") == 0) {
+                exec_mode_opt = riscv_tlm::BLOCK;
+            } else {
+                exec_mode_opt = riscv_tlm::INTERPRETER;
+            }
+            break;
+        case 'J':
+            jit_opt = true;
+            break;
+        case 'K':
+            jit_opt = true;
+            jit_check_opt = true;
+            break;
+        case 'G':
+            fuse_opt = true;
+            break;
+        case 'S':
+            mem_size_opt = parse_size(optarg);
+            break;
+        case 'A':
+            mem_base_opt = std::strtoull(optarg, nullptr, 16);
+            break;
+        case 'C':
+            checkpoint_save_opt = std::string(optarg);
+            break;
+        case 'N':
+            checkpoint_time_opt = std::strtoull(optarg, nullptr, 10);
+            break;
+        case 'U':
+            checkpoint_restore_opt = std::string(optarg);
+            break;
+        case 'Q':
+            quantum_opt = std::strtoull(optarg, nullptr, 10);
+            break;
+        case 'V':
+            variants_opt = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'F':
+            fork_time_opt = std::strtoull(optarg, nullptr, 10);
+            break;
+        case 'j':
+            fork_jobs_opt = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'a':
+            variant_addr_opt = std::strtoull(optarg, nullptr, 16);
+            break;
+        case 'X':
+            fast_opt = true;
+            break;
+        case 'P':
+            spin_skip_opt = std::strtoull(optarg, nullptr, 10);
+            break;
+        case 'I':
+            cpi_opt = std::strtoul(optarg, nullptr, 10);
+            break;
+        case 'O':
+            stats_opt = std::string(optarg);
+            break;
+        case 'W':
+            trace_bin_opt = std::string(optarg);
+            break;
+        case 'Z':
+            if (strcmp(optarg, "lz4") == 0) {
+                trace_codec_opt = riscv_tlm::trace::CODEC_LZ4;
+            } else if (strcmp(optarg, "zstd") == 0) {
+                trace_codec_opt = riscv_tlm::trace::CODEC_ZSTD;
             } else {
-                cpu_type_opt = riscv_tlm::RV64;
+                trace_codec_opt = riscv_tlm::trace::CODEC_NONE;
+            }
+            if (!riscv_tlm::InstrLog::codecAvailable(trace_codec_opt)) {
+                std::cerr << "Trace compression " << optarg << " not compiled in, trace is not compressed" << std::endl;
             }
             break;
 		case '?':
-			std::cout << "Call ./RISCV_TLM -D -L <debuglevel> (0..3) filename.hex"
+			std::cout << "Call ./RISCV_TLM -D -L <debuglevel> (0..3) [--mode interp|block] [--jit] [--fast] [--mem-size <size>] [--mem-base <hex addr>] filename.hex"
 					<< std::endl;
 			break;
 		default:
@@ -223,7 +533,7 @@ void process_arguments(int argc, char *argv[]) {
 		}
 	}
 
-	if (filename.empty()) {
+	if (filename.empty() && (optind < argc)) {
 		filename = std::string(argv[optind]);
 	}
 
@@ -232,8 +542,6 @@ void process_arguments(int argc, char *argv[]) {
 
 int sc_main(int argc, char *argv[]) {
 
-  Performance *perf = Performance::getInstance();
-
 	/* Capture Ctrl+C and finish the simulation */
 	signal(SIGINT, intHandler);
 
@@ -250,19 +558,33 @@ int sc_main(int argc, char *argv[]) {
         logger->set_level(spdlog::level::info);
     }
 
+	if (variants_opt != 0) {
+		unsigned int jobs = (fork_jobs_opt != 0) ? fork_jobs_opt : std::thread::hardware_concurrency();
+		sweep = new riscv_tlm::Sweep(variants_opt, jobs);
+	}
+
+	if (fast_opt) {
+		riscv_tlm::FastScheduler::getInstance()->enable();
+	}
+
 	top = new Simulator("top", cpu_type_opt);
 
 	auto start = std::chrono::steady_clock::now();
-	sc_core::sc_start();
+	if (fast_opt) {
+		top->run_fast();
+	} else {
+		sc_core::sc_start();
+	}
 	auto end = std::chrono::steady_clock::now();
 
 	std::chrono::duration<double> elapsed_seconds = end - start;
-    double instructions = static_cast<double>(perf->getInstructions()) / elapsed_seconds.count();
+    std::uint64_t executed = top->cpu->getPerformance()->getInstructions();
+    double instructions = static_cast<double>(executed) / elapsed_seconds.count();
 
 	std::cout << "Total elapsed time: " << elapsed_seconds.count() << "s" << std::endl;
 	std::cout << "Simulated " << int(std::round(instructions)) << " instr/sec" << std::endl;
 
-	if (!mem_dump)
+	if (!mem_dump && (sweep == nullptr))
     {
         std::cout << "Press Enter to finish" << std::endl;
         std::cin.ignore();
@@ -271,5 +593,19 @@ int sc_main(int argc, char *argv[]) {
 	// call all destructors, clean exit.
 	delete top;
 
+	if (sweep != nullptr) {
+		if (sweep->isChild()) {
+			riscv_tlm::Sweep::variant_result result{};
+			result.variant = sweep->getVariant();
+			result.instructions = executed - fork_instructions;
+			result.sim_time = riscv_tlm::FastScheduler::time_stamp();
+			result.signature_hash = signature_hash;
+			sweep->report(result);
+		} else {
+			sweep->dump();
+		}
+		delete sweep;
+	}
+
 	return 0;
 }
@@ -0,0 +1,124 @@
+/*!
+ \file Sweep.cpp
+ \brief Run many variants of a simulation from a common state
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Sweep.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace riscv_tlm {
+
+    Sweep::Sweep(unsigned int variants_num, unsigned int jobs_num) :
+            variants(variants_num), jobs(std::max(jobs_num, 1u)), variant(-1), result_fd(-1) {
+    }
+
+    int Sweep::fork_variants() {
+        /* pid -> (variant, read end of its pipe) */
+        std::map<pid_t, std::pair<unsigned int, int>> running;
+        unsigned int next = 0;
+
+        /* Buffered output would be printed by every child */
+        std::cout.flush();
+        std::fflush(stdout);
+
+        while ((next < variants) || !running.empty()) {
+            while ((next < variants) && (running.size() < jobs)) {
+                int fds[2];
+
+                if (pipe(fds) != 0) {
+                    std::perror("Sweep: pipe");
+                    variants = next;
+                    break;
+                }
+
+                pid_t pid = fork();
+                if (pid == 0) {
+                    /* Child: go on with the simulation */
+                    close(fds[0]);
+                    for (const auto &child : running) {
+                        close(child.second.second);
+                    }
+                    variant = static_cast<int>(next);
+                    result_fd = fds[1];
+                    return variant;
+                }
+
+                close(fds[1]);
+                if (pid < 0) {
+                    std::perror("Sweep: fork");
+                    close(fds[0]);
+                    variants = next;
+                    break;
+                }
+                running[pid] = std::make_pair(next, fds[0]);
+                next++;
+            }
+
+            if (running.empty()) {
+                break;
+            }
+
+            int status;
+            pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0) {
+                std::perror("Sweep: waitpid");
+                break;
+            }
+
+            auto it = running.find(pid);
+            if (it == running.end()) {
+                continue;
+            }
+
+            variant_result result{};
+            if (read(it->second.second, &result, sizeof(result)) != sizeof(result)) {
+                result = variant_result{};
+            }
+            result.variant = it->second.first;
+            result.status = WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+            close(it->second.second);
+            results.push_back(result);
+            running.erase(it);
+        }
+
+        std::sort(results.begin(), results.end(),
+                  [](const variant_result &a, const variant_result &b) { return a.variant < b.variant; });
+        return -1;
+    }
+
+    void Sweep::report(const variant_result &result) {
+        if (result_fd < 0) {
+            return;
+        }
+
+        if (write(result_fd, &result, sizeof(result)) != sizeof(result)) {
+            std::perror("Sweep: write");
+        }
+        close(result_fd);
+        result_fd = -1;
+    }
+
+    void Sweep::dump() const {
+        std::cout << "# Variant | Status | Instructions | Sim. time (ns) | Signature hash" << std::endl;
+        for (const auto &result : results) {
+            std::cout << std::dec << std::setw(9) << result.variant << " | "
+                      << std::setw(6) << result.status << " | "
+                      << std::setw(12) << result.instructions << " | "
+                      << std::setw(14) << result.sim_time << " | "
+                      << std::hex << std::setw(16) << std::setfill('0') << result.signature_hash
+                      << std::setfill(' ') << std::dec << std::endl;
+        }
+    }
+}
@@ -7,6 +7,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "Timer.h"
+#include "Checkpoint.h"
+#include "FastScheduler.h"
+#include "Performance.h"
+#include <algorithm>
 #include <cstdint>
 
 namespace riscv_tlm::peripherals {
@@ -14,7 +18,9 @@ namespace riscv_tlm::peripherals {
     SC_HAS_PROCESS(Timer);
 
     Timer::Timer(sc_core::sc_module_name const &name) :
-            sc_module(name), socket("timer_socket"), m_mtime(0), m_mtimecmp(0) {
+            sc_module(name), socket("timer_socket"), m_mtime(0), m_mtimecmp(0), time_offset(0),
+            restored_event(sc_core::SC_ZERO_TIME), event_id(0),
+            spin_skip(0), spin_polls(0), last_poll(0), perf(nullptr) {
 
         socket.register_b_transport(this, &Timer::b_transport);
 
@@ -23,24 +29,49 @@ namespace riscv_tlm::peripherals {
 
     [[noreturn]] void Timer::run() {
 
-        auto *irq_trans = new tlm::tlm_generic_payload;
-        sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
-        std::uint32_t cause = 1 << 31 | 0x07;     // Machine timer interrupt
-        irq_trans->set_command(tlm::TLM_WRITE_COMMAND);
-        irq_trans->set_data_ptr(reinterpret_cast<unsigned char *>(&cause));
-        irq_trans->set_data_length(4);
-        irq_trans->set_streaming_width(4);
-        irq_trans->set_byte_enable_ptr(nullptr);
-        irq_trans->set_dmi_allowed(false);
-        irq_trans->set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
-        irq_trans->set_address(0);
+        if (restored_event != sc_core::SC_ZERO_TIME) {
+            schedule_event(restored_event.value());
+        }
 
         while (true) {
             wait(timer_event);
-            irq_line->b_transport(*irq_trans, delay);
+            raise_irq();
         }
     }
 
+    void Timer::schedule_event(std::uint64_t delay) {
+        auto *scheduler = FastScheduler::getInstance();
+
+        if (!scheduler->isEnabled()) {
+            timer_event.notify(sc_core::sc_time::from_value(delay));
+            return;
+        }
+
+        /* Heap entries cannot be removed, a new mtimecmp makes the old one stale */
+        std::uint64_t id = ++event_id;
+        scheduler->schedule(scheduler->now() + delay, [this, id]() {
+            if (id == event_id) {
+                raise_irq();
+            }
+        });
+    }
+
+    void Timer::raise_irq() {
+        tlm::tlm_generic_payload irq_trans;
+        sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+        std::uint32_t cause = 1 << 31 | 0x07;     // Machine timer interrupt
+        irq_trans.set_command(tlm::TLM_WRITE_COMMAND);
+        irq_trans.set_data_ptr(reinterpret_cast<unsigned char *>(&cause));
+        irq_trans.set_data_length(4);
+        irq_trans.set_streaming_width(4);
+        irq_trans.set_byte_enable_ptr(nullptr);
+        irq_trans.set_dmi_allowed(false);
+        irq_trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        irq_trans.set_address(0);
+
+        irq_line->b_transport(irq_trans, delay);
+    }
+
     void Timer::b_transport(tlm::tlm_generic_payload &trans,
                             sc_core::sc_time &delay) {
 
@@ -50,30 +81,42 @@ namespace riscv_tlm::peripherals {
         unsigned int len = trans.get_data_length();
         delay = sc_core::SC_ZERO_TIME;
 
-        std::uint32_t aux_value = 0;
+        std::uint64_t aux_value = 0;
 
+        /* RV64 accesses both halves of the register at once */
+        bool full = (len == 8);
 
         if (cmd == tlm::TLM_WRITE_COMMAND) {
+            spin_polls = 0;
             memcpy(&aux_value, ptr, len);
             switch (addr) {
                 case TIMER_MEMORY_ADDRESS_LO:
-                    m_mtime.range(31, 0) = aux_value;
+                    if (full) {
+                        m_mtime = aux_value;
+                    } else {
+                        m_mtime.range(31, 0) = aux_value;
+                    }
                     break;
                 case TIMER_MEMORY_ADDRESS_HI:
                     m_mtime.range(63, 32) = aux_value;
                     break;
                 case TIMERCMP_MEMORY_ADDRESS_LO:
-                    m_mtimecmp.range(31, 0) = aux_value;
-                    break;
+                    if (!full) {
+                        m_mtimecmp.range(31, 0) = aux_value;
+                        break;
+                    }
+                    m_mtimecmp = aux_value;
+                    [[fallthrough]];
                 case TIMERCMP_MEMORY_ADDRESS_HI:
-                    m_mtimecmp.range(63, 32) = aux_value;
+                    if (!full) {
+                        m_mtimecmp.range(63, 32) = aux_value;
+                    }
 
                     std::uint64_t notify_time;
                     // notify needs relative time, mtimecmp works in absolute time
                     notify_time = m_mtimecmp - m_mtime;
 
-                    //timer_event.notify(sc_core::sc_time(notify_time, sc_core::SC_NS));
-                    timer_event.notify(sc_core::sc_time::from_value(notify_time));
+                    schedule_event(notify_time);
                     break;
                 default:
                     trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
@@ -82,14 +125,17 @@ namespace riscv_tlm::peripherals {
         } else { // TLM_READ_COMMAND
             switch (addr) {
                 case TIMER_MEMORY_ADDRESS_LO:
-                    m_mtime = sc_core::sc_time_stamp().value();
-                    aux_value = m_mtime.range(31, 0);
+                    m_mtime = FastScheduler::time_stamp() + time_offset;
+                    aux_value = full ? m_mtime.to_uint64() : m_mtime.range(31, 0).to_uint64();
+                    if (spin_skip != 0) {
+                        delay = spin_delay();
+                    }
                     break;
                 case TIMER_MEMORY_ADDRESS_HI:
                     aux_value = m_mtime.range(63, 32);
                     break;
                 case TIMERCMP_MEMORY_ADDRESS_LO:
-                    aux_value = m_mtimecmp.range(31, 0);
+                    aux_value = full ? m_mtimecmp.to_uint64() : m_mtimecmp.range(31, 0).to_uint64();
                     break;
                 case TIMERCMP_MEMORY_ADDRESS_HI:
                     aux_value = m_mtimecmp.range(63, 32);
@@ -103,4 +149,48 @@ namespace riscv_tlm::peripherals {
 
         trans.set_response_status(tlm::TLM_OK_RESPONSE);
     }
+
+    sc_core::sc_time Timer::spin_delay() {
+        std::uint64_t instructions = perf->getInstructions();
+
+        if (instructions - last_poll > SPIN_WINDOW) {
+            spin_polls = 0;
+        } else {
+            spin_polls++;
+        }
+        last_poll = instructions;
+
+        if (spin_polls < SPIN_THRESHOLD) {
+            return sc_core::SC_ZERO_TIME;
+        }
+
+        std::uint64_t skip = spin_skip;
+        /* Do not jump over the timer interrupt */
+        if (m_mtimecmp > m_mtime) {
+            skip = std::min<std::uint64_t>(skip, m_mtimecmp - m_mtime);
+        }
+        return sc_core::sc_time::from_value(skip);
+    }
+
+    void Timer::saveState(std::ostream &out) {
+        Checkpoint::put<std::uint64_t>(out, FastScheduler::time_stamp() + time_offset);
+        Checkpoint::put<std::uint64_t>(out, m_mtimecmp.to_uint64());
+    }
+
+    bool Timer::restoreState(std::istream &in) {
+        auto mtime = Checkpoint::get<std::uint64_t>(in);
+        auto mtimecmp = Checkpoint::get<std::uint64_t>(in);
+
+        /* mtime goes on from the saved value instead of restarting at 0 */
+        time_offset = mtime - FastScheduler::time_stamp();
+        m_mtime = mtime;
+        m_mtimecmp = mtimecmp;
+
+        /* Event is notified when the run() thread starts */
+        if (mtimecmp > mtime) {
+            restored_event = sc_core::sc_time::from_value(mtimecmp - mtime);
+        }
+
+        return in.good();
+    }
 }
\ No newline at end of file
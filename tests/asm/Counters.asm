@@ -0,0 +1,54 @@
+# minstret and mcycle read back to back through their CSR numbers must
+# strictly increase: csrr (csrrs rd, csr, x0) and csrrsi/csrrci with
+# uimm 0 only read the CSR. Prints "OK" or "FAIL" to the Trace device and
+# leaves a1 = 1 on success, a1 = 0 on failure in the register dump.
+.equ TRACE_BASE, 0x40000000
+
+.section .text
+.globl _start
+
+_start:
+  li s0, TRACE_BASE
+  li a1, 0
+
+  csrr t0, minstret
+  csrr t1, minstret
+  csrr t2, minstret
+  bgeu t0, t1, fail
+  bgeu t1, t2, fail
+
+  csrr t0, mcycle
+  csrr t1, mcycle
+  bgeu t0, t1, fail
+
+  csrrsi t0, minstret, 0
+  csrrci t1, minstret, 0
+  csrrc t2, minstret, zero
+  bgeu t0, t1, fail
+  bgeu t1, t2, fail
+
+  csrrsi t0, mcycle, 0
+  csrrci t1, mcycle, 0
+  bgeu t0, t1, fail
+
+  li a1, 1
+  li a0, 'O'
+  sb a0, 0(s0)
+  li a0, 'K'
+  sb a0, 0(s0)
+  j done
+
+fail:
+  li a0, 'F'
+  sb a0, 0(s0)
+  li a0, 'A'
+  sb a0, 0(s0)
+  li a0, 'I'
+  sb a0, 0(s0)
+  li a0, 'L'
+  sb a0, 0(s0)
+
+done:
+  li a0, '\n'
+  sb a0, 0(s0)
+  ebreak
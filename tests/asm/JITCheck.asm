@@ -0,0 +1,60 @@
+# Hot blocks with loads, stores, CSR accesses and device accesses, for the
+# JIT differential test. Run it with --mode block --jit-check, simulation
+# stops with "JIT check failed" at the first difference.
+.equ TRACE_BASE, 0x40000000
+.equ TIMER_BASE, 0x40004000
+.equ BUFFER, 0x10000
+
+.section .text
+.globl _start
+
+_start:
+  li s0, TRACE_BASE
+  li s1, TIMER_BASE
+  li s2, BUFFER
+  li s3, 100
+  li s4, 0x80           # mstatus.MPIE, kept clear so MRET leaves IRQs off
+  csrw mscratch, zero
+
+outer:
+  li t0, 64
+  mv t1, s2
+
+inner:
+  lw t2, 0(t1)
+  addi t2, t2, 3
+  sw t2, 0(t1)
+  lbu t3, 1(t1)
+  xori t3, t3, 0x5a
+  sb t3, 2(t1)
+  lh t4, 2(t1)
+  sh t4, 6(t1)
+  csrrs t5, mscratch, t2
+  csrrw t6, mscratch, t5
+  add t5, t5, t2
+  csrr a0, minstret     # counters read after some instructions of the block
+  sub t6, t6, a0
+  xor t5, t5, t6
+  csrr a1, mcycle
+  add t5, t5, a1
+  addi t1, t1, 4
+  addi t0, t0, -1
+  bnez t0, inner
+
+  lw a2, 0(s1)          # mtime
+  add s5, s5, a2
+  li a3, '.'
+  sb a3, 0(s0)
+
+  la a4, resume         # MRET to resume
+  csrw mepc, a4
+  csrc mstatus, s4
+  mret
+
+resume:
+  addi s3, s3, -1
+  bnez s3, outer
+
+  li a3, '\n'
+  sb a3, 0(s0)
+  ebreak
@@ -0,0 +1,32 @@
+#!/bin/bash
+# Runs a program with --trace-bin in the interpreter and with --jit and
+# compares the decoded commit traces. Needs a build with ENABLE_INSTR_LOG.
+# The program must not read mtime: block mode advances simulated time per
+# block, so timer values differ from the interpreter.
+# usage: trace_jit.sh <build dir> <program (.hex or ELF)> [simulator args]
+
+BUILD=$1
+PROGRAM=$2
+shift 2
+
+if [ -z "$BUILD" ] || [ -z "$PROGRAM" ]; then
+    echo "usage: $0 <build dir> <program> [simulator args]"
+    exit 2
+fi
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+"$BUILD"/RISCV_TLM -f "$PROGRAM" --trace-bin "$TMP"/interp.bin "$@" < /dev/null > "$TMP"/interp.out 2>&1
+"$BUILD"/RISCV_TLM -f "$PROGRAM" --mode block --jit --trace-bin "$TMP"/jit.bin "$@" < /dev/null > "$TMP"/jit.out 2>&1
+
+"$BUILD"/trace_decode "$TMP"/interp.bin > "$TMP"/interp.txt || exit 1
+"$BUILD"/trace_decode "$TMP"/jit.bin > "$TMP"/jit.txt || exit 1
+
+if ! cmp -s "$TMP"/interp.txt "$TMP"/jit.txt; then
+    echo "FAIL: traces differ"
+    diff "$TMP"/interp.txt "$TMP"/jit.txt | head -20
+    exit 1
+fi
+
+echo "OK: $(wc -l < "$TMP"/interp.txt) instructions traced"
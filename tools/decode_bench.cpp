@@ -0,0 +1,94 @@
+/*!
+ \file decode_bench.cpp
+ \brief Micro-benchmark of the instruction decoder
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Decoder.h"
+
+using namespace riscv_tlm;
+
+namespace {
+
+    /**
+     * @brief Random legal instructions, about half of them compressed
+     * like in usual RV32IMAC/RV64IMAC code
+     */
+    std::vector<std::uint32_t> make_workload(const Decoder &decoder, std::size_t size) {
+        std::vector<std::uint32_t> words;
+        std::mt19937 rng(1);
+
+        words.reserve(size);
+        while (words.size() < size) {
+            std::uint32_t instr = rng();
+            extension_t extension;
+            std::uint32_t code;
+
+            if (words.size() & 1) {
+                instr &= 0xFFFF;
+            } else {
+                instr |= 0b11;
+            }
+
+            decoder.decode(instr, &extension, &code);
+            if (extension != UNKNOWN_EXTENSION) {
+                words.push_back(instr);
+            }
+        }
+        return words;
+    }
+
+    void run(unsigned int xlen, unsigned int rounds) {
+        Decoder decoder(xlen);
+        std::vector<std::uint32_t> words = make_workload(decoder, 4096);
+        std::array<std::uint64_t, UNKNOWN_EXTENSION + 1> histogram{};
+        std::uint64_t checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int round = 0; round < rounds; round++) {
+            for (auto instr : words) {
+                extension_t extension;
+                std::uint32_t code;
+
+                decoder.decode(instr, &extension, &code);
+                histogram[extension]++;
+                checksum += code;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        double decoded = static_cast<double>(words.size()) * rounds;
+
+        std::printf("RV%u: %.0f instructions in %.3f s, %.2f ns/instr, %.1f Minstr/s (checksum %llu)\n",
+                    xlen, decoded, seconds, seconds * 1e9 / decoded, decoded / seconds / 1e6,
+                    static_cast<unsigned long long>(checksum));
+        std::printf("      base %llu, C %llu, M %llu, A %llu\n",
+                    static_cast<unsigned long long>(histogram[BASE_EXTENSION]),
+                    static_cast<unsigned long long>(histogram[C_EXTENSION]),
+                    static_cast<unsigned long long>(histogram[M_EXTENSION]),
+                    static_cast<unsigned long long>(histogram[A_EXTENSION]));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int rounds = 10000;
+
+    if (argc > 1) {
+        rounds = static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    run(32, rounds);
+    run(64, rounds);
+
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*!
+ \file trace_decode.cpp
+ \brief Decodes binary commit traces written with --trace-bin
+ \author Màrius Montón
+ \date October 2026
+ */
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "TraceFormat.h"
+
+using namespace riscv_tlm;
+
+namespace {
+
+    bool spike_format = false;
+    unsigned int xlen = 32;
+
+    /**
+     * @brief Print one value with the number of digits of its size
+     */
+    void print_hex(std::uint64_t value, unsigned int bytes) {
+        std::printf("0x%0*" PRIx64, static_cast<int>(bytes * 2), value);
+    }
+
+    /**
+     * @brief Decode and print the records of a block
+     * @return false if the block is truncated
+     */
+    bool print_block(const std::uint8_t *data, std::size_t size, std::uint32_t records, std::uint64_t *index) {
+        const std::uint8_t *end = data + size;
+        std::uint64_t next_pc = 0;
+        std::uint64_t prev_mem_addr = 0;
+        unsigned int xbytes = xlen / 8;
+
+        for (std::uint32_t i = 0; i < records; i++) {
+            std::uint64_t value;
+            std::size_t len;
+
+            if (data >= end) {
+                return false;
+            }
+            std::uint8_t flags = *data++;
+
+            std::uint64_t pc = next_pc;
+            if (flags & trace::FLAG_JUMP) {
+                if ((len = trace::get_varint(data, end, &value)) == 0) {
+                    return false;
+                }
+                data += len;
+                pc += static_cast<std::uint64_t>(trace::unzigzag(value));
+            }
+
+            unsigned int length = (flags & trace::FLAG_COMPRESSED) ? 2 : 4;
+            if (data + length > end) {
+                return false;
+            }
+            std::uint32_t instr = 0;
+            for (unsigned int b = 0; b < length; b++) {
+                instr |= static_cast<std::uint32_t>(data[b]) << (8 * b);
+            }
+            data += length;
+            next_pc = pc + length;
+
+            unsigned int rd = 0;
+            std::uint64_t rd_value = 0;
+            if (flags & trace::FLAG_RD) {
+                if (data >= end) {
+                    return false;
+                }
+                rd = *data++;
+                if ((len = trace::get_varint(data, end, &rd_value)) == 0) {
+                    return false;
+                }
+                data += len;
+            }
+
+            std::uint64_t mem_addr = 0;
+            std::uint64_t mem_data = 0;
+            unsigned int mem_size = 0;
+            if (flags & trace::FLAG_MEM) {
+                if ((len = trace::get_varint(data, end, &value)) == 0) {
+                    return false;
+                }
+                data += len;
+                mem_addr = prev_mem_addr + static_cast<std::uint64_t>(trace::unzigzag(value));
+                prev_mem_addr = mem_addr;
+                if (data >= end) {
+                    return false;
+                }
+                mem_size = *data++;
+                if ((len = trace::get_varint(data, end, &mem_data)) == 0) {
+                    return false;
+                }
+                data += len;
+            }
+
+            if (spike_format) {
+                /* Same layout as spike --log-commits, always machine mode */
+                std::printf("core   0: 3 ");
+                print_hex(pc, xbytes);
+                std::printf(" (");
+                print_hex(instr, length);
+                std::printf(")");
+                if (flags & trace::FLAG_RD) {
+                    std::printf(" x%-2u ", rd);
+                    print_hex(rd_value, xbytes);
+                }
+                if (flags & trace::FLAG_MEM) {
+                    std::printf(" mem ");
+                    print_hex(mem_addr, xbytes);
+                    if (flags & trace::FLAG_STORE) {
+                        std::printf(" ");
+                        print_hex(mem_data, mem_size);
+                    }
+                }
+            } else {
+                std::printf("%" PRIu64 " ", *index);
+                print_hex(pc, xbytes);
+                std::printf(" ");
+                print_hex(instr, length);
+                if (flags & trace::FLAG_RD) {
+                    std::printf(" x%u=", rd);
+                    print_hex(rd_value, xbytes);
+                }
+                if (flags & trace::FLAG_MEM) {
+                    std::printf((flags & trace::FLAG_STORE) ? " store " : " load ");
+                    print_hex(mem_addr, xbytes);
+                    std::printf(" (%u) ", mem_size);
+                    print_hex(mem_data, mem_size);
+                }
+            }
+            std::printf("\n");
+            (*index)++;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Uncompress a block
+     * @return false if the codec is not compiled in or data is corrupted
+     */
+    bool uncompress(trace::codec_t codec, const std::vector<char> &in, std::size_t in_size,
+                    std::vector<std::uint8_t> *out, std::size_t out_size) {
+        switch (codec) {
+#ifdef HAVE_LZ4
+            case trace::CODEC_LZ4:
+                return LZ4_decompress_safe(in.data(), reinterpret_cast<char *>(out->data()),
+                                           static_cast<int>(in_size), static_cast<int>(out_size))
+                       == static_cast<int>(out_size);
+#endif
+#ifdef HAVE_ZSTD
+            case trace::CODEC_ZSTD:
+                return ZSTD_decompress(out->data(), out_size, in.data(), in_size) == out_size;
+#endif
+            default:
+                (void) in;
+                (void) in_size;
+                (void) out;
+                (void) out_size;
+                return false;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *filename = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--spike") == 0) {
+            spike_format = true;
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    if (filename == nullptr) {
+        std::fprintf(stderr, "Call ./trace_decode [--spike] trace_file\n");
+        return 1;
+    }
+
+    std::FILE *file = std::fopen(filename, "rb");
+    if (file == nullptr) {
+        std::fprintf(stderr, "Cannot open %s\n", filename);
+        return 1;
+    }
+
+    trace::file_header header{};
+    if ((std::fread(&header, sizeof(header), 1, file) != 1) ||
+        (std::memcmp(header.magic, "RVTLMTRC", sizeof(header.magic)) != 0) ||
+        (header.version != trace::VERSION)) {
+        std::fprintf(stderr, "%s is not a trace file (version %u)\n", filename, trace::VERSION);
+        std::fclose(file);
+        return 1;
+    }
+    xlen = header.xlen;
+
+    std::vector<char> stored;
+    std::vector<std::uint8_t> raw;
+    std::uint64_t index = 0;
+    trace::block_header block{};
+    int ret = 0;
+
+    while (std::fread(&block, sizeof(block), 1, file) == 1) {
+        stored.resize(block.stored_size);
+        raw.resize(block.raw_size);
+
+        if (std::fread(stored.data(), 1, block.stored_size, file) != block.stored_size) {
+            std::fprintf(stderr, "Truncated block after record %" PRIu64 "\n", index);
+            ret = 1;
+            break;
+        }
+
+        if (block.stored_size == block.raw_size) {
+            std::memcpy(raw.data(), stored.data(), block.raw_size);
+        } else if (!uncompress(header.codec, stored, block.stored_size, &raw, block.raw_size)) {
+            std::fprintf(stderr, "Cannot uncompress block after record %" PRIu64 " (codec %u)\n",
+                         index, static_cast<unsigned int>(header.codec));
+            ret = 1;
+            break;
+        }
+
+        if (!print_block(raw.data(), block.raw_size, block.records, &index)) {
+            std::fprintf(stderr, "Corrupted block after record %" PRIu64 "\n", index);
+            ret = 1;
+            break;
+        }
+    }
+
+    std::fclose(file);
+    return ret;
+}